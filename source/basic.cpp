@@ -34,12 +34,41 @@ OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
 **************************************************************/
 //============================================
 #include "basic.hpp"
+#include "file-checksum.hpp"
+#include "file-record.hpp"
 #include <filesystem>
+#include <algorithm>
 //============================================
 namespace ict { namespace  queue {
 //============================================
-basic::basic(const ict::queue::types::path_t & dirname,const std::size_t & maxFileSize,const std::size_t & maxFiles):
-    max_file_size(maxFileSize),iface(dirname,maxFileSize,maxFiles){
+basic::basic(const ict::queue::types::path_t & dirname,const std::size_t & maxFileSize,const std::size_t & maxFiles,const ict::queue::types::options_t & options):
+    max_file_size(maxFileSize),iface(dirname,maxFileSize,maxFiles,options){
+    if ((options.durability==ict::queue::types::periodic_durability)&&options.sync_interval_ms) syncThread=std::thread(&basic::syncExpired,this);
+}
+basic::~basic(){
+    {
+        std::lock_guard<std::mutex> lock(syncMutex);
+        syncStop=true;
+    }
+    syncCond.notify_all();
+    if (syncThread.joinable()) syncThread.join();
+}
+void basic::syncExpired(){
+    std::unique_lock<std::mutex> lock(syncMutex);
+    while (!syncStop){
+        std::chrono::steady_clock::time_point next;
+        lock.unlock();
+        {
+            std::lock_guard<std::mutex> lock(writeMutex);
+            next=iface.syncWriteExpired();
+        }
+        {
+            std::lock_guard<std::mutex> lock(readMutex);
+            next=std::min(next,iface.syncCursorExpired());
+        }
+        lock.lock();
+        syncCond.wait_until(lock,next,[this]{return syncStop;});
+    }
 }
 void basic::writeSize(const std::size_t & size){
     {
@@ -50,19 +79,45 @@ void basic::writeSize(const std::size_t & size){
         if (iface.empty()){
             iface.nextWriteStream();
         }
-        iface.getWriteStream()<<writeRecord;
     }
 }
 void basic::writeContent(const char * content){
     if (!content) throw std::invalid_argument("ict::queue::basic content is null!");
+    ict::queue::types::const_buffer_t buffer={content,writeRecord.data};
+    writeContent(&buffer,1);
+}
+//! Liczba buforów elementu, dla których nie jest alokowana pamięć.
+static const std::size_t max_stack_buffers=16;
+void basic::writeContent(const ict::queue::types::const_buffer_t * buffers,const std::size_t & count){
+    std::size_t size=0;
+    if ((!buffers)&&count) throw std::invalid_argument("ict::queue::basic content is null!");
+    for (std::size_t k=0;k<count;k++){
+        if ((!buffers[k].data)&&buffers[k].size) throw std::invalid_argument("ict::queue::basic content is null!");
+        size+=buffers[k].size;
+    }
     {
         std::lock_guard<std::mutex> lock(writeMutex);
         if (!writeOperation) throw std::domain_error("ict::queue::basic writeSize should be done first!");
-        if (writeRecord.data) iface.getWriteStream().write(content,writeRecord.data);
-        iface.getWriteStream().flush();
+        if (size!=writeRecord.data) throw std::invalid_argument("ict::queue::basic content size differs from writeSize()!");
+        ict::queue::types::const_buffer_t local[max_stack_buffers+1];
+        ict::queue::types::const_buffers_t allocated;
+        ict::queue::types::const_buffer_t * parts=local;
+        if (max_stack_buffers<count){
+            allocated.resize(count+1);
+            parts=allocated.data();
+        }
+        char header[ict::queue::file::max_record_size];
+        std::size_t position=iface.getWriteStream().tellp();
+        writeRecord.checksum=ict::queue::file::checksum(buffers,count,writeRecord.data);
+        parts[0]={header,ict::queue::file::encodeRecord(writeRecord,iface.writeFormat(),header)};
+        for (std::size_t k=0;k<count;k++) parts[k+1]=buffers[k];
+        iface.beginWriteStream();
+        iface.getWriteStream().write(parts,count+1);
+        // Numer kolejny jest zwiększany przed zatwierdzeniem zapisu, które go publikuje (zob. ict::queue::file::interface::flushWriteStream()).
+        iface.indexWriteStream(iface.writeSequence()++,position);
+        iface.commitWriteStream(parts[0].size+writeRecord.data);
         writeRecord.data=0;
     }
-    iface.queueSize()++;
     {
         std::lock_guard<std::mutex> lock(writeMutex);
         writeOperation=false;
@@ -71,29 +126,117 @@ void basic::writeContent(const char * content){
         }
     }
 }
+void basic::writeBatch(const ict::queue::types::const_buffers_t & contents){
+    ict::queue::types::gathers_t gathers;
+    gathers.reserve(contents.size());
+    for (const ict::queue::types::const_buffer_t & c : contents) gathers.push_back({&c,1});
+    writeBatch(gathers);
+}
+void basic::writeBatch(const ict::queue::types::gathers_t & contents){
+    std::size_t count=0;
+    std::size_t bytes=0;
+    std::size_t parts=0;
+    for (const ict::queue::types::gather_t & g : contents){
+        if ((!g.buffers)&&g.count) throw std::invalid_argument("ict::queue::basic content is null!");
+        for (std::size_t k=0;k<g.count;k++){
+            if ((!g.buffers[k].data)&&g.buffers[k].size) throw std::invalid_argument("ict::queue::basic content is null!");
+        }
+        parts+=g.count+1;
+    }
+    if (contents.empty()) return;
+    {
+        std::lock_guard<std::mutex> lock(writeMutex);
+        if (writeOperation) throw std::domain_error("ict::queue::basic writeContent should be done now!");
+        if (iface.empty()){
+            iface.nextWriteStream();
+        }
+        std::vector<char> headers(contents.size()*ict::queue::file::max_record_size);
+        std::vector<std::size_t> offsets(contents.size());
+        ict::queue::types::const_buffers_t buffers;
+        std::size_t position=iface.getWriteStream().tellp();
+        ict::queue::types::format_t format=iface.writeFormat();
+        // Elementy dodawane do indeksu dopiero po zapisie danych.
+        auto indexed=[&](std::size_t last){
+            for (std::size_t i=last-count;i<last;i++) iface.indexWriteStream(iface.writeSequence()++,offsets[i]);
+        };
+        buffers.reserve(parts);
+        for (std::size_t k=0;k<contents.size();k++){
+            std::size_t size=0;
+            char * header=headers.data()+k*ict::queue::file::max_record_size;
+            offsets[k]=position;
+            for (std::size_t i=0;i<contents[k].count;i++) size+=contents[k].buffers[i].size;
+            const ict::queue::types::record_t r(ict::queue::types::payload_checksum_record,size,ict::queue::file::checksum(contents[k].buffers,contents[k].count,size));
+            const std::size_t n=ict::queue::file::encodeRecord(r,format,header);
+            buffers.push_back({header,n});
+            for (std::size_t i=0;i<contents[k].count;i++) buffers.push_back(contents[k].buffers[i]);
+            position+=n+size;
+            bytes+=n+size;
+            count++;
+            if (max_file_size<position){
+                iface.beginWriteStream();
+                iface.getWriteStream().write(buffers.data(),buffers.size());
+                indexed(k+1);
+                iface.commitWriteStream(bytes);
+                buffers.clear();
+                bytes=0;
+                count=0;
+                iface.nextWriteStream();
+                position=iface.getWriteStream().tellp();
+                format=iface.writeFormat();
+            }
+        }
+        if (!buffers.empty()){
+            iface.beginWriteStream();
+            iface.getWriteStream().write(buffers.data(),buffers.size());
+        }
+        indexed(contents.size());
+        iface.commitWriteStream(bytes);
+    }
+}
 void basic::readSize(std::size_t & size){
-    if (iface.queueSize()==0) throw std::underflow_error("ict::queue::basic is empty!");
     {
         std::lock_guard<std::mutex> lock(readMutex);
         bool loop=true;
+        bool end=false;
+        bool reread=false;
+        if (iface.queueSize()<=readPending) throw std::underflow_error("ict::queue::basic is empty!");
         if (readOperation) throw std::domain_error("ict::queue::basic readContent shuld be done now!");
+        if (peekOperation) throw std::domain_error("ict::queue::basic readCommit or readAbort shuld be done now!");
+        {
+            std::lock_guard<std::mutex> lock(writeMutex);
+            iface.flushWriteStream();
+        }
         readOperation=true;
         while (loop){
-            while(loop&&iface.getReadStream()){
-                iface.getReadStream()>>readRecord;
-                if (iface.getReadStream()) switch(readRecord.type){
+            while(loop&&(!end)&&iface.getReadStream()){
+                readHeader=ict::queue::file::readRecord(iface.getReadStream(),iface.readFormat(),readRecord);
+                if (readHeader) switch(readRecord.type){
                     case ict::queue::types::payload_size_record:
+                    case ict::queue::types::payload_checksum_record:
                         loop=false;
                         break;
+                    case ict::queue::types::end_of_data_record:
+                        // Bufor strumienia mógł być nieaktualny - zmiana pozycji go odrzuca, więc rekord jest odczytywany ponownie (raz).
+                        iface.getReadStream().seekg(-(std::streamoff)readHeader,std::ios::cur);
+                        end=reread;
+                        reread=!reread;
+                        break;
+                    case ict::queue::types::padding_record:
+                        iface.getReadStream().seekg(readRecord.data,std::ios::cur);
+                        break;
                     case ict::queue::types::read_pointer_record:
                     case ict::queue::types::read_confirm_record:
                     case ict::queue::types::queue_size_record:
+                    case ict::queue::types::read_count_record:
                     default:break;
                 };
             }
             if (loop) {
                 if (1<iface.size()) {
+                    if (handoff) handoff();
                     iface.nextReadStream();
+                    end=false;
+                    reread=false;
                 } else {
                     break;
                 }
@@ -104,43 +247,212 @@ void basic::readSize(std::size_t & size){
     }
 }
 void basic::readContent(char * content){
-    if (!content) throw std::invalid_argument("ict::queue::basic content is null!");
-    ict::queue::types::record_t record={ict::queue::types::read_confirm_record,0};
+    readContent(content,true);
+}
+bool basic::verify(const char * content) const{
+    if (readRecord.type!=ict::queue::types::payload_checksum_record) return true;
+    ict::queue::types::const_buffer_t buffer={content,readRecord.data};
+    return ict::queue::file::checksum(&buffer,1,readRecord.data)==readRecord.checksum;
+}
+void basic::readDamaged(){
+    iface.commitReadStream(1);
+    peekOperation=false;
+    peekSize=0;
+    readRecord.data=0;
+    throw std::domain_error("ict::queue::basic element is damaged (checksum error)!");
+}
+void basic::readContent(char * content,const bool & confirm){
+    bool damaged;
     {
         std::lock_guard<std::mutex> lock(readMutex);
         if (!readOperation) throw std::domain_error("ict::queue::basic readSize shuld be done first!");
+        if ((!content)&&readRecord.data) throw std::invalid_argument("ict::queue::basic content is null!");
         if (readRecord.data) iface.getReadStream().read(content,readRecord.data);
+        damaged=!verify(content);
         readRecord.data=0;
-        record.data=iface.getReadStream().tellg();
+        if (confirm){
+            // Potwierdzenie odczytu jest zapisywane w pliku kursora (plik do zapisu nie jest zmieniany).
+            iface.commitReadStream(1);
+        } else {
+            readPending++;
+        }
+        readOperation=false;
+    }
+    if (damaged) throw std::domain_error("ict::queue::basic element is damaged (checksum error)!");
+}
+void basic::readConfirm(){
+    std::lock_guard<std::mutex> lock(readMutex);
+    if (readOperation) throw std::domain_error("ict::queue::basic readContent shuld be done now!");
+    if (!readPending) return;
+    iface.commitReadStream(readPending);
+    readPending=0;
+}
+void basic::flush(){
+    std::lock_guard<std::mutex> lock(readMutex);
+    if (readPending){
+        iface.commitReadStream(readPending);
+        readPending=0;
     }
     {
         std::lock_guard<std::mutex> lock(writeMutex);
-        if (iface.empty()){
-            iface.nextWriteStream();
-        }
-        iface.getWriteStream()<<record;
-        iface.getWriteStream().flush();
+        iface.flush();
+    }
+}
+void basic::seek(const std::uint64_t & sequence){
+    std::lock_guard<std::mutex> lock(readMutex);
+    if (readOperation) throw std::domain_error("ict::queue::basic readContent shuld be done now!");
+    if (peekOperation) throw std::domain_error("ict::queue::basic readCommit or readAbort shuld be done now!");
+    if (readPending){
+        iface.commitReadStream(readPending);
+        readPending=0;
+    }
+    {
+        std::lock_guard<std::mutex> lock(writeMutex);
+        iface.flushWriteStream();
+        iface.seek(sequence);
     }
-    iface.queueSize()--;
+}
+std::uint64_t basic::readSequence(){
+    std::lock_guard<std::mutex> lock(readMutex);
+    return iface.readSequence()+readPending;
+}
+std::uint64_t basic::writeSequence(){
+    std::lock_guard<std::mutex> lock(writeMutex);
+    return iface.writeSequence();
+}
+void basic::peekContent(char * content){
+    std::lock_guard<std::mutex> lock(readMutex);
+    if (!readOperation) throw std::domain_error("ict::queue::basic readSize shuld be done first!");
+    if ((!content)&&readRecord.data) throw std::invalid_argument("ict::queue::basic content is null!");
+    if (readRecord.data) iface.getReadStream().read(content,readRecord.data);
+    peekSize=readRecord.data;
+    readOperation=false;
+    peekOperation=true;
+    if (!verify(content)) readDamaged();
+    readRecord.data=0;
+}
+void basic::peekView(std::shared_ptr<const ict::queue::file::mapping> & m,std::string_view & content){
+    std::lock_guard<std::mutex> lock(readMutex);
+    std::size_t offset;
+    if (!readOperation) throw std::domain_error("ict::queue::basic readSize shuld be done first!");
+    offset=iface.getReadStream().tellg();
+    m=iface.mapReadStream(offset+readRecord.data);
+    content=std::string_view(m->get()+offset,readRecord.data);
+    if (readRecord.data) iface.getReadStream().seekg(readRecord.data,std::ios::cur);
+    peekSize=readRecord.data;
+    readOperation=false;
+    peekOperation=true;
+    if (!verify(content.data())) readDamaged();
+    readRecord.data=0;
+}
+void basic::readCommit(){
+    bool reload;
     {
         std::lock_guard<std::mutex> lock(readMutex);
-        readOperation=false;
-        if (max_file_size<iface.getWriteStream().tellp()){
-            iface.nextWriteStream();
+        if (!peekOperation) throw std::domain_error("ict::queue::basic peekContent shuld be done first!");
+        reload=peekReload;
+    }
+    if (reload){
+        // Po przeładowaniu plików element jest odczytywany ponownie (pierwszy element w kolejce powinien być podglądanym elementem).
+        std::size_t s;
+        std::size_t expected;
+        {
+            std::lock_guard<std::mutex> lock(readMutex);
+            expected=peekSize;
+            peekOperation=false;
+            peekReload=false;
+            peekSize=0;
         }
+        readSize(s);
+        std::lock_guard<std::mutex> lock(readMutex);
+        if (s!=expected){
+            iface.getReadStream().seekg(-(std::streamoff)readHeader,std::ios::cur);
+            readRecord.data=0;
+            readOperation=false;
+            throw std::domain_error("ict::queue::basic peeked element has been removed!");
+        }
+        iface.getReadStream().seekg(s,std::ios::cur);
+        readRecord.data=0;
+        readOperation=false;
+        peekOperation=true;
+        peekSize=s;
+    }
+    {
+        std::lock_guard<std::mutex> lock(readMutex);
+        iface.commitReadStream(1);
+        peekOperation=false;
+        peekSize=0;
     }
 }
+bool basic::peeked(){
+    std::lock_guard<std::mutex> lock(readMutex);
+    return peekOperation;
+}
+void basic::readAbort(){
+    std::lock_guard<std::mutex> lock(readMutex);
+    if (peekOperation){
+        if (!peekReload) iface.getReadStream().seekg(-(std::streamoff)(readHeader+peekSize),std::ios::cur);
+        peekOperation=false;
+        peekReload=false;
+        peekSize=0;
+        return;
+    }
+    if (!readOperation) throw std::domain_error("ict::queue::basic readSize shuld be done first!");
+    iface.getReadStream().seekg(-(std::streamoff)readHeader,std::ios::cur);
+    readRecord.data=0;
+    readOperation=false;
+}
 std::size_t basic::size() {
-    return iface.queueSize();
+    std::lock_guard<std::mutex> lock(readMutex);
+    const std::size_t s=iface.queueSize();
+    // Elementy odczytane bez potwierdzenia nie są już w kolejce.
+    return (readPending<s)?(s-readPending):0;
 }
 bool basic::empty() {
-    return iface.queueSize()==0;
+    return size()==0;
+}
+bool basic::writeHandoff(const std::size_t & count,const std::size_t & size) {
+    std::lock_guard<std::mutex> lock(writeMutex);
+    if (iface.empty()) return true;
+    // Rekordy są liczone z maksymalnym rozmiarem - plik jest zamykany, gdy zapis przekroczy jego maksymalny rozmiar.
+    return max_file_size<((std::size_t)iface.getWriteStream().tellp()+count*ict::queue::file::max_record_size+size);
+}
+void basic::setHandoff(const std::function<void()> & callback) {
+    handoff=callback;
+}
+std::size_t basic::files() {
+    std::lock_guard<std::mutex> lock(writeMutex);
+    return iface.size();
+}
+bool basic::full(const std::size_t & size) {
+    std::lock_guard<std::mutex> lock(writeMutex);
+    return iface.full(ict::queue::file::encodedSize({ict::queue::types::payload_checksum_record,size},iface.writeFormat())+size);
 }
 void basic::clear(){
+    readPending=0;
+    peekOperation=false;
+    peekReload=false;
+    peekSize=0;
     iface.clear();
 }
+void basic::publish(){
+    std::lock_guard<std::mutex> lock(writeMutex);
+    iface.publish();
+}
+bool basic::state(ict::queue::types::state_t & s){
+    return iface.state(s);
+}
+bool basic::sync(const ict::queue::file::control::part_t & side){
+    return iface.sync(side);
+}
 bool basic::refresh(){
-    return iface.refresh();
+    if (iface.refresh()){
+        // Pliki zostały przeładowane - pozycja odczytu wskazuje teraz na początek podglądanego elementu.
+        std::lock_guard<std::mutex> lock(readMutex);
+        if (peekOperation) peekReload=true;
+        return true;
+    }
+    return false;
 }
 //===========================================
 } }
@@ -148,6 +460,10 @@ bool basic::refresh(){
 #ifdef ENABLE_TESTING
 #include "test.hpp"
 #include <filesystem>
+#include <fstream>
+#include <map>
+#include <thread>
+#include <chrono>
 
 static ict::queue::types::path_t dirpath("/tmp/test-basic");
 REGISTER_TEST(basic,tc1){
@@ -395,5 +711,636 @@ REGISTER_TEST(basic,tc5){
     std::filesystem::remove_all(dirpath);
     return out;
 }
+REGISTER_TEST(basic,tc6){
+    int out=0;
+    std::filesystem::remove_all(dirpath);
+    std::filesystem::create_directory(dirpath);
+    {
+        ict::queue::basic queue(dirpath,100);
+        ict::queue::types::const_buffers_t contents;
+        for (size_t i=0;i<ict::test::test_string.size();i++){
+            contents.push_back({ict::test::test_string.at(i).data(),ict::test::test_string.at(i).size()});
+        }
+        queue.writeBatch(contents);
+        if (ict::test::test_string.size()!=queue.size()){
+            std::cerr<<"test_string.size()="<<ict::test::test_string.size()<<std::endl;//27
+            std::cerr<<"queue.size()="<<queue.size()<<std::endl;
+            out=1;
+        }
+    }
+    if (out==0) {
+        ict::queue::basic queue(dirpath,100);
+        if (ict::test::test_string.size()!=queue.size()){
+            std::cerr<<"test_string.size()="<<ict::test::test_string.size()<<std::endl;//27
+            std::cerr<<"queue.size()="<<queue.size()<<std::endl;
+            out=2;
+        }
+        for (size_t i=0;(out==0)&&(i<ict::test::test_string.size());i++){
+            std::size_t s;
+            std::string c;
+            queue.readSize(s);
+            c.resize(s);
+            queue.readContent(&c[0]);
+            if (ict::test::test_string.at(i)!=c){
+                std::cerr<<"test_string["<<i<<"]="<<ict::test::test_string.at(i)<<std::endl;
+                std::cerr<<"c="<<c<<std::endl;
+                out=3;
+            }
+        }
+        if ((out==0)&&(queue.size()!=0)){
+            std::cerr<<"queue.size()="<<queue.size()<<std::endl;
+            out=4;
+        }
+    }
+    std::filesystem::remove_all(dirpath);
+    return out;
+}
+//! Tryby trwałości zapisu sprawdzane dla każdego sposobu zapisu.
+static const ict::queue::types::durability_t test_modes[]={
+    ict::queue::types::buffered_durability,
+    ict::queue::types::flush_durability,
+    ict::queue::types::fdatasync_durability,
+    ict::queue::types::periodic_durability
+};
+//! 
+//! @brief Zapisuje elementy (pojedynczo, na przemian z odczytem, i partią), a potem otwiera kolejkę ponownie i odczytuje je
+//!        (w każdym otwarciu elementy są odczytywane i zapisywane ponownie partią, więc kolejne otwarcie zastaje częściowo zapisany plik).
+//! 
+//! @param options Opcje kolejki.
+//! @param maxFileSize Maksymalny rozmiar pliku.
+//! @param rounds Liczba ponownych otwarć.
+//! @return Wynik testu (0 - poprawny).
+//! 
+static int reopenTest(const ict::queue::types::options_t & options,const std::size_t & maxFileSize,const std::size_t & rounds){
+    int out=0;
+    ict::queue::types::const_buffers_t contents;
+    for (const std::string & s : ict::test::test_string) contents.push_back({s.data(),s.size()});
+    std::filesystem::remove_all(dirpath);
+    std::filesystem::create_directory(dirpath);
+    {
+        ict::queue::basic queue(dirpath,maxFileSize,0xffffffff,options);
+        for (size_t i=0;(out==0)&&(i<ict::test::test_string.size());i++){
+            std::size_t s;
+            std::string c;
+            queue.writeSize(ict::test::test_string.at(i).size());
+            queue.writeContent(ict::test::test_string.at(i).data());
+            queue.readSize(s);
+            c.resize(s);
+            queue.readContent(&c[0]);
+            if (ict::test::test_string.at(i)!=c){
+                std::cerr<<"test_string["<<i<<"]="<<ict::test::test_string.at(i)<<std::endl;
+                std::cerr<<"c="<<c<<std::endl;
+                out=1;
+            }
+        }
+        queue.writeBatch(contents);
+    }
+    for (std::size_t round=0;(out==0)&&(round<rounds);round++) {
+        ict::queue::basic queue(dirpath,maxFileSize,0xffffffff,options);
+        if (ict::test::test_string.size()!=queue.size()){
+            std::cerr<<"queue.size()="<<queue.size()<<std::endl;
+            out=2;
+        }
+        for (size_t i=0;(out==0)&&(i<ict::test::test_string.size());i++){
+            std::size_t s;
+            std::string c;
+            queue.readSize(s);
+            c.resize(s);
+            queue.readContent(&c[0]);
+            if (ict::test::test_string.at(i)!=c){
+                std::cerr<<"test_string["<<i<<"]="<<ict::test::test_string.at(i)<<std::endl;
+                std::cerr<<"c="<<c<<std::endl;
+                out=3;
+            }
+        }
+        queue.writeBatch(contents);
+    }
+    std::filesystem::remove_all(dirpath);
+    return out;
+}
+REGISTER_TEST(basic,tc7){
+    int out=0;
+    const ict::queue::types::backend_t backends[]={
+        ict::queue::types::stream_backend,
+        ict::queue::types::descriptor_backend,
+        ict::queue::types::mmap_backend,
+        ict::queue::types::uring_backend,
+        ict::queue::types::direct_backend
+    };
+    for (const ict::queue::types::backend_t & backend : backends) for (const ict::queue::types::durability_t & mode : test_modes){
+        ict::queue::types::options_t options;
+        options.backend=backend;
+        options.durability=mode;
+        options.sync_interval_ms=1;
+        options.sync_interval_bytes=1000;
+        out=reopenTest(options,100,1);
+        if (out){
+            std::cerr<<"backend="<<backend<<", mode="<<mode<<std::endl;
+            break;
+        }
+    }
+    return out;
+}
+REGISTER_TEST(basic,tc8){
+    int out=0;
+    std::filesystem::remove_all(dirpath);
+    std::filesystem::create_directory(dirpath);
+    {
+        ict::queue::types::options_t options;
+        options.backend=ict::queue::types::descriptor_backend;
+        options.durability=ict::queue::types::buffered_durability;
+        ict::queue::basic queue(dirpath,1000000,0xffffffff,options);
+        for (size_t i=0;(out==0)&&(i<ict::test::test_string.size());i++){
+            std::uintmax_t before=0;
+            std::uintmax_t after=0;
+            for(auto& p: std::filesystem::directory_iterator(dirpath)) if (p.path().extension()==".dat") before+=std::filesystem::file_size(p);
+            queue.writeSize(ict::test::test_string.at(i).size());
+            queue.writeContent(ict::test::test_string.at(i).data());
+            for(auto& p: std::filesystem::directory_iterator(dirpath)) if (p.path().extension()==".dat") after+=std::filesystem::file_size(p);
+            // Rekord i dane są zapisywane od razu (writev, bez bufora strumienia) - także bez opróżniania po operacji.
+            if (after<(before+ict::test::test_string.at(i).size()+1)){
+                std::cerr<<"test_string["<<i<<"]="<<ict::test::test_string.at(i)<<std::endl;
+                std::cerr<<"before="<<before<<" after="<<after<<std::endl;
+                out=1;
+            }
+        }
+    }
+    std::filesystem::remove_all(dirpath);
+    return out;
+}
+REGISTER_TEST(basic,tc9){
+    int out=0;
+    const std::size_t max_file_size=1000;
+    for (const ict::queue::types::durability_t & mode : test_modes){
+        ict::queue::types::options_t options;
+        options.backend=ict::queue::types::mmap_backend;
+        options.durability=mode;
+        options.sync_interval_ms=1;
+        options.sync_interval_bytes=1000;
+        std::filesystem::remove_all(dirpath);
+        std::filesystem::create_directory(dirpath);
+        {
+            ict::queue::basic queue(dirpath,max_file_size,0xffffffff,options);
+            for (size_t i=0;i<ict::test::test_string.size();i++){
+                queue.writeSize(ict::test::test_string.at(i).size());
+                queue.writeContent(ict::test::test_string.at(i).data());
+            }
+        }
+        {
+            // Ostatni plik pozostaje zaalokowany do maksymalnego rozmiaru, a za danymi jest rekord końca danych.
+            ict::queue::types::path_t last;
+            for(auto& p: std::filesystem::directory_iterator(dirpath)) if ((p.path().extension()==".dat")&&(last<p.path().string())) last=p.path();
+            if (std::filesystem::file_size(last)!=max_file_size){
+                std::cerr<<"mode="<<mode<<std::endl;
+                std::cerr<<"file_size="<<std::filesystem::file_size(last)<<std::endl;
+                out=1;
+            }
+            if (out==0){
+                ict::queue::basic queue(dirpath,max_file_size,0xffffffff,options);
+                if (ict::test::test_string.size()!=queue.size()){
+                    std::cerr<<"mode="<<mode<<std::endl;
+                    std::cerr<<"queue.size()="<<queue.size()<<std::endl;
+                    out=2;
+                }
+            }
+        }
+        // Ponowne otwarcie częściowo zapisanego, zaalokowanego pliku (także kilka razy).
+        if (out==0) out=reopenTest(options,max_file_size,2);
+        if (out){
+            std::cerr<<"mode="<<mode<<std::endl;
+            break;
+        }
+    }
+    std::filesystem::remove_all(dirpath);
+    return out;
+}
+REGISTER_TEST(basic,tc10){
+    int out=0;
+    const std::size_t half=ict::test::test_string.size()/2;
+    std::filesystem::remove_all(dirpath);
+    std::filesystem::create_directory(dirpath);
+    {
+        std::uintmax_t before=0;
+        std::uintmax_t after=0;
+        ict::queue::basic queue(dirpath);
+        for (size_t i=0;i<ict::test::test_string.size();i++){
+            queue.writeSize(ict::test::test_string.at(i).size());
+            queue.writeContent(ict::test::test_string.at(i).data());
+        }
+        for(auto& p: std::filesystem::directory_iterator(dirpath)) if (p.path().extension()==".dat") before+=std::filesystem::file_size(p);
+        for (size_t i=0;(out==0)&&(i<half);i++){
+            std::size_t s;
+            std::string c;
+            queue.readSize(s);
+            c.resize(s);
+            queue.readContent(&c[0]);
+            if (ict::test::test_string.at(i)!=c){
+                std::cerr<<"test_string["<<i<<"]="<<ict::test::test_string.at(i)<<std::endl;
+                std::cerr<<"c="<<c<<std::endl;
+                out=1;
+            }
+        }
+        // Odczyt nie zmienia plików z danymi (pozycja odczytu jest w pliku kursora).
+        for(auto& p: std::filesystem::directory_iterator(dirpath)) if (p.path().extension()==".dat") after+=std::filesystem::file_size(p);
+        if ((out==0)&&((before!=after)||(!std::filesystem::exists(dirpath+"/read.cursor")))){
+            std::cerr<<"before="<<before<<" after="<<after<<std::endl;
+            out=2;
+        }
+    }
+    if (out==0) {
+        ict::queue::basic queue(dirpath);
+        if ((ict::test::test_string.size()-half)!=queue.size()){
+            std::cerr<<"queue.size()="<<queue.size()<<std::endl;
+            out=3;
+        }
+        for (size_t i=half;(out==0)&&(i<ict::test::test_string.size());i++){
+            std::size_t s;
+            std::string c;
+            queue.readSize(s);
+            c.resize(s);
+            queue.readContent(&c[0]);
+            if (ict::test::test_string.at(i)!=c){
+                std::cerr<<"test_string["<<i<<"]="<<ict::test::test_string.at(i)<<std::endl;
+                std::cerr<<"c="<<c<<std::endl;
+                out=4;
+            }
+        }
+    }
+    if (out==0) {
+        // Kolejka z wcześniejszej wersji (potwierdzenia odczytu w pliku do zapisu, bez pliku kursora).
+        std::filesystem::remove_all(dirpath);
+        std::filesystem::create_directory(dirpath);
+        std::ofstream f(dirpath+"/0000000000000000.dat",std::ios::out|std::ios::binary);
+        f<<ict::queue::types::record_t{ict::queue::types::queue_size_record,0};
+        f<<ict::queue::types::record_t{ict::queue::types::read_pointer_record,0};
+        for (size_t i=0;i<ict::test::test_string.size();i++){
+            f<<ict::queue::types::record_t{ict::queue::types::payload_size_record,ict::test::test_string.at(i).size()};
+            f.write(ict::test::test_string.at(i).data(),ict::test::test_string.at(i).size());
+            if (i<half) f<<ict::queue::types::record_t{ict::queue::types::read_confirm_record,(std::size_t)f.tellp()};
+        }
+    }
+    if (out==0) {
+        ict::queue::basic queue(dirpath,100);
+        if ((ict::test::test_string.size()-half)!=queue.size()){
+            std::cerr<<"queue.size()="<<queue.size()<<std::endl;
+            out=5;
+        }
+        for (size_t i=half;(out==0)&&(i<ict::test::test_string.size());i++){
+            std::size_t s;
+            std::string c;
+            // Nowy plik do zapisu (przed pierwszym odczytem) - pozycja odczytu jest przenoszona do pliku kursora.
+            queue.writeSize(ict::test::test_string.at(i).size());
+            queue.writeContent(ict::test::test_string.at(i).data());
+            queue.readSize(s);
+            c.resize(s);
+            queue.readContent(&c[0]);
+            if (ict::test::test_string.at(i)!=c){
+                std::cerr<<"test_string["<<i<<"]="<<ict::test::test_string.at(i)<<std::endl;
+                std::cerr<<"c="<<c<<std::endl;
+                out=6;
+            }
+        }
+    }
+    if (out==0) {
+        ict::queue::basic queue(dirpath,100);
+        if ((ict::test::test_string.size()-half)!=queue.size()){
+            std::cerr<<"queue.size()="<<queue.size()<<std::endl;
+            out=7;
+        }
+        for (size_t i=half;(out==0)&&(i<ict::test::test_string.size());i++){
+            std::size_t s;
+            std::string c;
+            queue.readSize(s);
+            c.resize(s);
+            queue.readContent(&c[0]);
+            if (ict::test::test_string.at(i)!=c){
+                std::cerr<<"test_string["<<i<<"]="<<ict::test::test_string.at(i)<<std::endl;
+                std::cerr<<"c="<<c<<std::endl;
+                out=8;
+            }
+        }
+        if ((out==0)&&(!queue.empty())){
+            std::cerr<<"queue.size()="<<queue.size()<<std::endl;
+            out=9;
+        }
+    }
+    std::filesystem::remove_all(dirpath);
+    return out;
+}
+REGISTER_TEST(basic,tc11){
+    int out=0;
+    ict::queue::types::options_t options;
+    options.confirm_interval=5;
+    std::filesystem::remove_all(dirpath);
+    std::filesystem::create_directory(dirpath);
+    {
+        ict::queue::basic queue(dirpath,1000000,0xffffffff,options);
+        for (size_t i=0;i<ict::test::test_string.size();i++){
+            queue.writeSize(ict::test::test_string.at(i).size());
+            queue.writeContent(ict::test::test_string.at(i).data());
+        }
+        for (size_t i=0;(out==0)&&(i<6);i++){
+            std::size_t s;
+            std::string c;
+            queue.readSize(s);
+            c.resize(s);
+            queue.readContent(&c[0]);
+            if (ict::test::test_string.at(i)!=c){
+                std::cerr<<"test_string["<<i<<"]="<<ict::test::test_string.at(i)<<std::endl;
+                std::cerr<<"c="<<c<<std::endl;
+                out=1;
+            }
+            if (out==0){
+                // Pozycja odczytu zapisana w pliku kursora (widoczna np. po awarii) - co 5 odczytów.
+                ict::queue::basic other(dirpath,1000000,0xffffffff,options);
+                std::size_t expected=ict::test::test_string.size()-((i<4)?0:5);
+                if (other.size()!=expected){
+                    std::cerr<<"i="<<i<<" other.size()="<<other.size()<<std::endl;
+                    out=2;
+                }
+            }
+        }
+    }
+    if (out==0) {
+        // Niepotwierdzony odczyt jest zapisywany przy zamknięciu kolejki.
+        ict::queue::basic queue(dirpath,1000000,0xffffffff,options);
+        if (queue.size()!=(ict::test::test_string.size()-6)){
+            std::cerr<<"queue.size()="<<queue.size()<<std::endl;
+            out=3;
+        }
+    }
+    options.confirm_interval=0;
+    options.confirm_interval_ms=100;
+    if (out==0) {
+        ict::queue::basic queue(dirpath,1000000,0xffffffff,options);
+        for (size_t i=6;(out==0)&&(i<8);i++){
+            std::size_t s;
+            std::string c;
+            if (i==7) std::this_thread::sleep_for(std::chrono::milliseconds(150));
+            queue.readSize(s);
+            c.resize(s);
+            queue.readContent(&c[0]);
+            if (ict::test::test_string.at(i)!=c){
+                std::cerr<<"test_string["<<i<<"]="<<ict::test::test_string.at(i)<<std::endl;
+                std::cerr<<"c="<<c<<std::endl;
+                out=4;
+            }
+            if (out==0){
+                ict::queue::basic other(dirpath,1000000,0xffffffff,options);
+                std::size_t expected=ict::test::test_string.size()-((i<7)?6:8);
+                if (other.size()!=expected){
+                    std::cerr<<"i="<<i<<" other.size()="<<other.size()<<std::endl;
+                    out=5;
+                }
+            }
+        }
+    }
+    std::filesystem::remove_all(dirpath);
+    return out;
+}
+REGISTER_TEST(basic,tc12){
+    int out=0;
+    const std::size_t max=ict::test::test_string.size();
+    ict::queue::file::checkpoint::state_t cp;
+    std::filesystem::remove_all(dirpath);
+    std::filesystem::create_directory(dirpath);
+    {
+        ict::queue::basic queue(dirpath);
+        for (size_t i=0;i<max;i++){
+            queue.writeSize(ict::test::test_string.at(i).size());
+            queue.writeContent(ict::test::test_string.at(i).data());
+        }
+    }
+    {
+        // Punkt kontrolny nowego pliku wskazuje na początek danych, a po otwarciu kolejki - na koniec pliku.
+        ict::queue::file::checkpoint c(dirpath);
+        ict::queue::basic queue(dirpath);
+        if (queue.size()!=max) out=1;
+        if ((out==0)&&(!c.load(cp))) out=2;
+        if ((out==0)&&((cp.size!=max)||(cp.offset!=std::filesystem::file_size(dirpath+"/0000000000000000.dat")))){
+            std::cerr<<"cp.size="<<cp.size<<" cp.offset="<<cp.offset<<std::endl;
+            out=3;
+        }
+    }
+    if (out==0) {
+        // Rozmiar jest odczytywany z punktu kontrolnego, a nie z rekordów pliku.
+        ict::queue::file::checkpoint c(dirpath);
+        cp.size=1000;
+        c.store(cp);
+        ict::queue::basic queue(dirpath);
+        if (queue.size()!=1000){
+            std::cerr<<"queue.size()="<<queue.size()<<std::endl;
+            out=4;
+        }
+    }
+    if (out==0) {
+        // Punkt kontrolny innego pliku (inny i-węzeł) jest pomijany.
+        ict::queue::file::checkpoint c(dirpath);
+        cp.inode++;
+        c.store(cp);
+        ict::queue::basic queue(dirpath);
+        if (queue.size()!=max) out=5;
+    }
+    if (out==0) {
+        // Brak punktu kontrolnego - odczyt całego pliku.
+        std::filesystem::remove(dirpath+"/size.checkpoint");
+        ict::queue::basic queue(dirpath);
+        if (queue.size()!=max) out=6;
+        for (size_t i=0;(out==0)&&(i<max);i++){
+            std::size_t s;
+            std::string c;
+            queue.readSize(s);
+            c.resize(s);
+            queue.readContent(&c[0]);
+            if (ict::test::test_string.at(i)!=c) out=7;
+        }
+    }
+    if (out==0) {
+        // Zapis po punkcie kontrolnym jest uwzględniany.
+        {
+            ict::queue::basic queue(dirpath);
+            queue.writeSize(ict::test::test_string.at(0).size());
+            queue.writeContent(ict::test::test_string.at(0).data());
+        }
+        ict::queue::basic queue(dirpath);
+        if (queue.size()!=1) out=8;
+    }
+    std::filesystem::remove_all(dirpath);
+    return out;
+}
+REGISTER_TEST(basic,tc13){
+    int out=0;
+    const std::size_t max=5;
+    auto write=[&](ict::queue::basic & queue,const std::string & c){
+        queue.writeSize(c.size());
+        queue.writeContent(c.data());
+    };
+    auto read=[&](ict::queue::basic & queue){
+        std::size_t s;
+        std::string c;
+        queue.readSize(s);
+        c.resize(s);
+        queue.readContent(&c[0]);
+        return c;
+    };
+    auto path=[&](){
+        for (const std::filesystem::directory_entry & e : std::filesystem::directory_iterator(dirpath)) if (e.path().extension()==".dat") return e.path().string();
+        return std::string();
+    };
+    // Przerwany zapis: niepełny rekord, rekord z błędną sumą kontrolną i kilka uszkodzonych rekordów na końcu pliku.
+    for (int variant=0;(out==0)&&(variant<3);variant++){
+        std::filesystem::remove_all(dirpath);
+        std::filesystem::create_directory(dirpath);
+        {
+            ict::queue::basic queue(dirpath);
+            for (size_t i=0;i<max;i++) write(queue,ict::test::test_string.at(i));
+        }
+        {
+            const ict::queue::types::format_t format=ict::queue::file::detectFormat(path(),ict::queue::types::legacy_format);
+            std::ofstream f(path(),std::ios::out|std::ios::app|std::ios::binary);
+            const std::string junk(50,'j');
+            for (int k=0;k<=variant;k++){
+                char header[ict::queue::file::max_record_size];
+                f.write(header,ict::queue::file::encodeRecord({ict::queue::types::payload_checksum_record,(variant==0)?junk.size():10,12345},format,header));
+                f.write(junk.data(),10);
+            }
+        }
+        {
+            ict::queue::basic queue(dirpath);
+            if (queue.size()!=max){
+                std::cerr<<"variant="<<variant<<" queue.size()="<<queue.size()<<std::endl;
+                out=1;
+            }
+            // Kolejny zapis usuwa przerwany zapis z pliku.
+            if (out==0) write(queue,"last");
+        }
+        if (out==0){
+            ict::queue::basic queue(dirpath);
+            if (queue.size()!=(max+1)) out=2;
+            for (size_t i=0;(out==0)&&(i<max);i++) if (read(queue)!=ict::test::test_string.at(i)) out=3;
+            if ((out==0)&&(read(queue)!="last")) out=4;
+        }
+    }
+    if (out==0) {
+        // Uszkodzony element w środku pliku (za nim są poprawne elementy) - jest usuwany z kolejki przy odczycie z wyjątkiem std::domain_error.
+        std::filesystem::remove_all(dirpath);
+        std::filesystem::create_directory(dirpath);
+        {
+            ict::queue::basic queue(dirpath);
+            for (size_t i=0;i<max;i++) write(queue,ict::test::test_string.at(i));
+        }
+        {
+            const ict::queue::types::format_t format=ict::queue::file::detectFormat(path(),ict::queue::types::legacy_format);
+            const std::size_t size[2]={ict::test::test_string.at(0).size(),ict::test::test_string.at(1).size()};
+            std::fstream f(path(),std::ios::in|std::ios::out|std::ios::binary);
+            // Pierwszy bajt danych drugiego elementu.
+            f.seekp(ict::queue::file::formatBegin(format)+
+                ict::queue::file::encodedSize({ict::queue::types::queue_size_record,0},format)+
+                ict::queue::file::encodedSize({ict::queue::types::read_count_record,0},format)+
+                ict::queue::file::encodedSize({ict::queue::types::payload_checksum_record,size[0]},format)+size[0]+
+                ict::queue::file::encodedSize({ict::queue::types::payload_checksum_record,size[1]},format));
+            f.put('#');
+        }
+        std::filesystem::remove(dirpath+"/size.checkpoint");
+        ict::queue::basic queue(dirpath);
+        if (queue.size()!=max) out=5;
+        if ((out==0)&&(read(queue)!=ict::test::test_string.at(0))) out=6;
+        if (out==0) try {
+            read(queue);
+            out=7;
+        } catch (const std::domain_error &) {}
+        if ((out==0)&&(queue.size()!=(max-2))) out=8;
+        for (size_t i=2;(out==0)&&(i<max);i++) if (read(queue)!=ict::test::test_string.at(i)) out=9;
+    }
+    std::filesystem::remove_all(dirpath);
+    return out;
+}
+REGISTER_TEST(basic,tc14){
+    int out=0;
+    const std::size_t max=ict::test::test_string.size();
+    auto read=[&](ict::queue::basic & queue){
+        std::size_t s;
+        std::string c;
+        queue.readSize(s);
+        c.resize(s);
+        queue.readContent(&c[0]);
+        return c;
+    };
+    auto files=[&](){
+        std::map<std::string,ict::queue::types::format_t> output;
+        for (const std::filesystem::directory_entry & e : std::filesystem::directory_iterator(dirpath)) if (e.path().extension()==".dat") {
+            output[e.path().string()]=ict::queue::file::detectFormat(e.path().string(),ict::queue::types::legacy_format);
+        }
+        return output;
+    };
+    auto bytes=[&](){
+        std::size_t output=0;
+        for (const std::filesystem::directory_entry & e : std::filesystem::directory_iterator(dirpath)) if (e.path().extension()==".dat") output+=e.file_size();
+        return output;
+    };
+    ict::queue::types::options_t legacy;
+    legacy.format=ict::queue::types::legacy_format;
+    std::filesystem::remove_all(dirpath);
+    std::filesystem::create_directory(dirpath);
+    {
+        // Pliki w formacie wcześniejszych wersji.
+        ict::queue::basic queue(dirpath,1000,0xffffffff,legacy);
+        for (size_t i=0;i<max;i++){
+            queue.writeSize(ict::test::test_string.at(i).size());
+            queue.writeContent(ict::test::test_string.at(i).data());
+        }
+    }
+    for (const auto & f : files()) if (f.second!=ict::queue::types::legacy_format) out=1;
+    if (out==0) {
+        // Plik do zapisu jest uzupełniany w swoim formacie, a nowe pliki mają nagłówek formatu compact_format.
+        std::size_t compact=0;
+        ict::queue::basic queue(dirpath,1000);
+        if (queue.size()!=max) out=2;
+        if ((out==0)&&(read(queue)!=ict::test::test_string.at(0))) out=3;
+        for (size_t i=0;(out==0)&&(i<max);i++){
+            queue.writeSize(ict::test::test_string.at(i).size());
+            queue.writeContent(ict::test::test_string.at(i).data());
+        }
+        for (const auto & f : files()) if (f.second==ict::queue::types::compact_format) compact++;
+        if ((out==0)&&((compact==0)||(compact==files().size()))){
+            std::cerr<<"compact="<<compact<<" files="<<files().size()<<std::endl;
+            out=4;
+        }
+    }
+    if (out==0) {
+        // Pliki w obu formatach są odczytywane po kolei.
+        ict::queue::basic queue(dirpath,1000);
+        if (queue.size()!=(2*max-1)){
+            std::cerr<<"queue.size()="<<queue.size()<<std::endl;
+            out=5;
+        }
+        for (size_t i=1;(out==0)&&(i<2*max);i++) if (read(queue)!=ict::test::test_string.at(i%max)) out=6;
+        if ((out==0)&&(!queue.empty())) out=7;
+    }
+    if (out==0) {
+        // Mniej bajtów na element o rozmiarze 40 bajtów (6 zamiast 16 bajtów rekordu).
+        const std::size_t count=1000;
+        const std::string item(40,'m');
+        std::size_t size[2];
+        for (int k=0;k<2;k++){
+            std::filesystem::remove_all(dirpath);
+            std::filesystem::create_directory(dirpath);
+            {
+                ict::queue::basic queue(dirpath,1000000,0xffffffff,(k==0)?legacy:ict::queue::types::options_t());
+                for (std::size_t i=0;i<count;i++){
+                    queue.writeSize(item.size());
+                    queue.writeContent(item.data());
+                }
+            }
+            size[k]=bytes();
+        }
+        if ((size[0]-size[1])<(count*(16-6))){
+            std::cerr<<"legacy="<<size[0]<<" compact="<<size[1]<<std::endl;
+            out=8;
+        }
+    }
+    std::filesystem::remove_all(dirpath);
+    return out;
+}
 #endif
 //===========================================
\ No newline at end of file
@@ -38,6 +38,11 @@ OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
 #include "types.hpp"
 #include "file-interface.hpp"
 #include <mutex>
+#include <memory>
+#include <string_view>
+#include <functional>
+#include <thread>
+#include <condition_variable>
 //============================================
 namespace ict { namespace  queue { 
 //===========================================
@@ -52,13 +57,50 @@ private:
     //! Mutex dla odczytu.
     std::mutex readMutex;
     //! Rekord do zapisania w pliku (informacja zapisie do kolejki).
-    ict::queue::types::record_t writeRecord={ict::queue::types::payload_size_record,0};
+    ict::queue::types::record_t writeRecord={ict::queue::types::payload_checksum_record,0};
     //! Rekord do zapisania w pliku (informacja odczycie z kolejki).
     ict::queue::types::record_t readRecord={ict::queue::types::read_confirm_record,0};
+    //! Rozmiar zakodowanego rekordu ostatnio odczytanego elementu (zob. readAbort()).
+    std::size_t readHeader=0;
     //! Flaga zapisu.
     bool writeOperation=false;
     //! Flaga odczytu.
     bool readOperation=false;
+    //! Liczba odczytanych elementów, których odczyt nie został jeszcze potwierdzony w pliku.
+    std::size_t readPending=0;
+    //! Flaga podglądu (element został odczytany, ale nie usunięty z kolejki).
+    bool peekOperation=false;
+    //! Rozmiar danych podglądanego elementu.
+    std::size_t peekSize=0;
+    //! Informacja, że pliki zostały przeładowane po podglądzie (pozycja odczytu wskazuje na początek podglądanego elementu).
+    bool peekReload=false;
+    //! Funkcja wywoływana przed przejściem odczytu do następnego pliku (zob. setHandoff()).
+    std::function<void()> handoff;
+    //! Wątek synchronizujący z dyskiem dane, których czas synchronizacji minął (tylko periodic_durability, zob. syncExpired()).
+    std::thread syncThread;
+    //! Mutex dla zatrzymania wątku synchronizującego.
+    std::mutex syncMutex;
+    //! Zmienna warunkowa, na której czeka wątek synchronizujący.
+    std::condition_variable syncCond;
+    //! Informacja, że wątek synchronizujący ma się zakończyć.
+    bool syncStop=false;
+    //! 
+    //! @brief Pętla wątku synchronizującego - synchronizuje plik do zapisu i plik kursora, gdy minie sync_interval_ms od ich
+    //!        ostatniej synchronizacji (także wtedy, gdy kolejka nie jest używana).
+    //! 
+    void syncExpired();
+    //! 
+    //! @brief Sprawdza sumę kontrolną odczytanego elementu (elementy z wcześniejszych wersji nie mają sumy kontrolnej).
+    //! 
+    //! @param content Dane elementu (rozmiar w readRecord).
+    //! @return true Suma kontrolna jest poprawna lub element nie ma sumy kontrolnej.
+    //! @return false Suma kontrolna jest błędna.
+    //! 
+    bool verify(const char * content) const;
+    //! 
+    //! @brief Usuwa z kolejki podglądany element z błędną sumą kontrolną i zgłasza wyjątek std::domain_error.
+    //! 
+    void readDamaged();
 public:
     //! 
     //! @brief Konstruktor kolejki.
@@ -66,8 +108,13 @@ public:
     //! @param dirname Ścieżka do katalogu z plikami.
     //! @param maxFileSize Maksymalny rozmiar pliku, po przekroczeniu którego tworzony jest nowy plik.
     //! @param maxFiles Maksymalna liczba plików w puli.
+    //! @param options Opcje kolejki (m.in. tryb trwałości zapisu).
+    //! 
+    basic(const ict::queue::types::path_t & dirname,const std::size_t & maxFileSize=1000000,const std::size_t & maxFiles=0xffffffff,const ict::queue::types::options_t & options=ict::queue::types::options_t());
+    //! 
+    //! @brief Destruktor kolejki (zatrzymuje wątek synchronizujący).
     //! 
-    basic(const ict::queue::types::path_t & dirname,const std::size_t & maxFileSize=1000000,const std::size_t & maxFiles=0xffffffff);
+    ~basic();
     //! 
     //! @brief Zapisuje informację o rozmiarze danych.
     //! 
@@ -81,6 +128,28 @@ public:
     //! 
     void writeContent(const char * content);
     //! 
+    //! @brief Zapisuje dane do kolejki z wielu buforów (jako jeden element). Wcześniej trzeba wykonać writeSize(),
+    //!        by wskazać rozmiar tych danych (sumę rozmiarów buforów).
+    //! 
+    //! @param buffers Bufory z danymi (zapisywane jeden za drugim).
+    //! @param count Liczba buforów.
+    //! 
+    void writeContent(const ict::queue::types::const_buffer_t * buffers,const std::size_t & count);
+    //! 
+    //! @brief Zapisuje wiele elementów do kolejki naraz (strumień jest opróżniany tylko raz, na końcu).
+    //!        Jeśli w trakcie zapisu zostanie przekroczony maksymalny rozmiar pliku, tworzony jest nowy plik.
+    //! 
+    //! @param contents Lista buforów z danymi kolejnych elementów.
+    //! 
+    void writeBatch(const ict::queue::types::const_buffers_t & contents);
+    //! 
+    //! @brief Zapisuje wiele elementów złożonych z wielu buforów do kolejki naraz (strumień jest opróżniany tylko raz, na końcu).
+    //!        Jeśli w trakcie zapisu zostanie przekroczony maksymalny rozmiar pliku, tworzony jest nowy plik.
+    //! 
+    //! @param contents Lista elementów (każdy złożony z jednego lub wielu buforów).
+    //! 
+    void writeBatch(const ict::queue::types::gathers_t & contents);
+    //! 
     //! @brief Odczytuje informację o rozmiarze danych.
     //! 
     //! @param size Rozmiar danych do odczytania z kolejki.
@@ -88,11 +157,82 @@ public:
     void readSize(std::size_t & size);
     //! 
     //! @brief Odczytuje dane z kolejki. Wcześniej trzeba wykonać readSize(), by poznać rozmiar tych danych.
+    //!        Element z błędną sumą kontrolną jest usuwany z kolejki i zgłaszany jest wyjątek std::domain_error.
     //! 
-    //! @param content Wskażnik do zapisu danych.
+    //! @param content Wskażnik do zapisu danych (może być pusty, jeśli element nie zawiera danych).
     //! 
     void readContent(char * content);
     //! 
+    //! @brief Odczytuje dane z kolejki bez zapisywania potwierdzenia odczytu w pliku (potwierdzenie zapisuje readConfirm()).
+    //!        Wcześniej trzeba wykonać readSize(), by poznać rozmiar tych danych.
+    //!        Element z błędną sumą kontrolną jest usuwany z kolejki i zgłaszany jest wyjątek std::domain_error.
+    //! 
+    //! @param content Wskażnik do zapisu danych (może być pusty, jeśli element nie zawiera danych).
+    //! @param confirm Czy zapisać potwierdzenie odczytu od razu.
+    //! 
+    void readContent(char * content,const bool & confirm);
+    //! 
+    //! @brief Zapisuje jedno potwierdzenie odczytu dla wszystkich elementów odczytanych bez potwierdzenia
+    //!        (pozycja odczytu i liczba odczytanych elementów w pliku kursora).
+    //! 
+    void readConfirm();
+    //! 
+    //! @brief Zapisuje pozycję odczytu (także niepotwierdzonych odczytów, zob. confirm_interval) i opróżnia plik do zapisu,
+    //!        tak aby stan kolejki był widoczny dla innych procesów.
+    //! 
+    void flush();
+    //! 
+    //! @brief Zmienia pozycję odczytu - następnym odczytanym elementem będzie element o podanym numerze kolejnym
+    //!        (wcześniejsze elementy są usuwane z kolejki; pozycja może zostać cofnięta w obrębie najstarszego pliku).
+    //! 
+    //! @param sequence Numer kolejny elementu.
+    //! 
+    void seek(const std::uint64_t & sequence);
+    //! 
+    //! @brief Zwraca numer kolejny następnego elementu do odczytu (także podglądanego elementu).
+    //! 
+    //! @return Numer kolejny elementu.
+    //! 
+    std::uint64_t readSequence();
+    //! 
+    //! @brief Zwraca numer kolejny następnego zapisanego elementu.
+    //! 
+    //! @return Numer kolejny elementu.
+    //! 
+    std::uint64_t writeSequence();
+    //! 
+    //! @brief Odczytuje dane z kolejki bez usuwania elementu (podgląd). Element usuwa readCommit(),
+    //!        a readAbort() przywraca pozycję odczytu sprzed readSize(). Wcześniej trzeba wykonać readSize().
+    //!        Element z błędną sumą kontrolną jest usuwany z kolejki i zgłaszany jest wyjątek std::domain_error.
+    //! 
+    //! @param content Wskażnik do zapisu danych (może być pusty, jeśli element nie zawiera danych).
+    //! 
+    void peekContent(char * content);
+    //! 
+    //! @brief Podgląd elementu bez kopiowania danych - widok wskazuje na dane w pliku odwzorowanym w pamięci.
+    //!        Element usuwa readCommit(), a readAbort() przywraca pozycję odczytu sprzed readSize(). Wcześniej trzeba wykonać readSize().
+    //!        Element z błędną sumą kontrolną jest usuwany z kolejki i zgłaszany jest wyjątek std::domain_error.
+    //! 
+    //! @param m Odwzorowanie pliku, do którego należy widok (widok jest ważny, dopóki istnieje odwzorowanie).
+    //! @param content Widok danych elementu.
+    //! 
+    void peekView(std::shared_ptr<const ict::queue::file::mapping> & m,std::string_view & content);
+    //! 
+    //! @brief Usuwa z kolejki element odczytany przez peekContent() (zapisuje potwierdzenie odczytu).
+    //! 
+    void readCommit();
+    //! 
+    //! @brief Sprawdza, czy jest element odczytany przez peekContent() i jeszcze nie usunięty z kolejki.
+    //! 
+    //! @return true Jest taki element.
+    //! @return false Nie ma takiego elementu.
+    //! 
+    bool peeked();
+    //! 
+    //! @brief Przerywa odczyt rozpoczęty przez readSize() lub podgląd (peekContent()) - element pozostaje w kolejce.
+    //! 
+    void readAbort();
+    //! 
     //! @brief Zwraca aktualny rozmiar kolejki.
     //! 
     //! @return Rozmiar kolejki.
@@ -106,10 +246,64 @@ public:
     //! 
     bool empty();
     //! 
+    //! @brief Sprawdza, czy zapis elementów może utworzyć nowy plik. Nowy plik zmienia pulę plików i pozycję odczytu zapisaną w pliku kursora,
+    //!        więc taki zapis nie może być wykonywany równocześnie z odczytem.
+    //! 
+    //! @param count Liczba elementów.
+    //! @param size Łączny rozmiar danych elementów.
+    //! @return true Zapis może utworzyć nowy plik.
+    //! @return false Elementy zmieszczą się w pliku do zapisu.
+    //! 
+    bool writeHandoff(const std::size_t & count,const std::size_t & size);
+    //! 
+    //! @brief Ustawia funkcję wywoływaną przed przejściem odczytu do następnego pliku (usunięciem odczytanego pliku z puli),
+    //!        np. aby wstrzymać zapis na czas tej zmiany.
+    //! 
+    //! @param callback Funkcja.
+    //! 
+    void setHandoff(const std::function<void()> & callback);
+    //! 
+    //! @brief Zwraca liczbę plików kolejki.
+    //! 
+    //! @return Liczba plików.
+    //! 
+    std::size_t files();
+    //! 
+    //! @brief Sprawdza, czy element o podanym rozmiarze nie zmieści się w kolejce (przekroczyłby maksymalną liczbę plików).
+    //! 
+    //! @param size Rozmiar danych elementu.
+    //! @return true Kolejka jest pełna.
+    //! @return false Element może zostać dodany.
+    //! 
+    bool full(const std::size_t & size);
+    //! 
     //! @brief Czyści kolejkę.
     //! 
     void clear();
     //! 
+    //! @brief Publikuje stan kolejki w pliku blokady katalogu (obie strony kolejki muszą być zablokowane, zob. state()). Operacje
+    //!        na jednej stronie kolejki publikują jej stan same (zapis - po opróżnieniu strumienia, odczyt - po zatwierdzeniu).
+    //! 
+    void publish();
+    //! 
+    //! @brief Odczytuje stan kolejki opublikowany w pliku blokady katalogu (bez blokowania katalogu). Stan jest ważny tylko wtedy,
+    //!        gdy po publikacji pliki kolejki nie zostały zmienione (także przez ict::queue::basic lub przerwany zapis).
+    //! 
+    //! @param s Stan kolejki.
+    //! @return true Stan został odczytany.
+    //! @return false Stan nie jest ważny (trzeba go odczytać pod blokadą).
+    //! 
+    bool state(ict::queue::types::state_t & s);
+    //! 
+    //! @brief Przygotowuje operację na jednej stronie kolejki bez sprawdzania plików - stan puli plików i tej strony musi być aktualny,
+    //!        a stan drugiej strony jest uzupełniany jej opublikowaną pozycją (zob. ict::queue::file::interface::sync()).
+    //! 
+    //! @param side Strona kolejki (ict::queue::file::control::write_part lub ict::queue::file::control::read_part).
+    //! @return true Operacja może zostać wykonana.
+    //! @return false Pliki trzeba sprawdzić (zob. refresh()).
+    //! 
+    bool sync(const ict::queue::file::control::part_t & side);
+    //! 
     //! @brief Sprawdza, czy interfejs wymaga przeładowania i przeładowuje, jeśli jest to potrzebne. 
     //! 
     bool refresh();
@@ -0,0 +1,463 @@
+#include <iostream>
+#include <sstream>
+#include <fstream>
+#include <string>
+#include <vector>
+#include <chrono>
+#include <filesystem>
+#include <functional>
+#include <algorithm>
+#include <thread>
+#include "single.hpp"
+#include "pool.hpp"
+#include "prioritized.hpp"
+#include <unistd.h>
+#include <fcntl.h>
+#include <sys/wait.h>
+//=================================================
+// Pomiar czasu otwarcia kolejek (zimny start) - każdy pomiar w nowym procesie, po usunięciu plików kolejki z pamięci podręcznej systemu.
+//=================================================
+typedef std::chrono::steady_clock bench_clock_t;
+struct bench_options_t {
+    std::vector<std::size_t> elements={1000,1000000,10000000};
+    std::vector<std::size_t> file_sizes={1000000,100000000};
+    std::vector<std::size_t> ids={10,1000,100000};
+    std::size_t per_id=10;
+    std::size_t item_size=100;
+    bool throughput=false;
+    std::size_t operations=1000000;
+};
+static std::vector<std::size_t> parseList(const std::string & s){
+    std::vector<std::size_t> output;
+    std::stringstream b(s);
+    std::string item;
+    while (std::getline(b,item,',')) if (!item.empty()) output.push_back(std::stoul(item));
+    return output;
+}
+static double milliseconds(const bench_clock_t::duration & d){
+    return std::chrono::duration_cast<std::chrono::microseconds>(d).count()/1000.0;
+}
+static void dropCache(const ict::queue::types::path_t & dir){
+    for (const std::filesystem::directory_entry & e : std::filesystem::recursive_directory_iterator(dir)){
+        if (!e.is_regular_file()) continue;
+        int fd=::open(e.path().c_str(),O_RDONLY);
+        if (fd<0) continue;
+        ::fdatasync(fd);
+        ::posix_fadvise(fd,0,0,POSIX_FADV_DONTNEED);
+        ::close(fd);
+    }
+}
+static void buildSingle(const ict::queue::types::path_t & dir,std::size_t elements,std::size_t maxFileSize,std::size_t itemSize){
+    ict::queue::single q(dir,maxFileSize);
+    std::vector<std::string> batch(10000,std::string(itemSize,'x'));
+    for (std::size_t k=0;k<elements;k+=batch.size()){
+        if ((elements-k)<batch.size()) batch.resize(elements-k);
+        q.push_batch(batch);
+    }
+}
+template<class Pool> static void buildPool(const ict::queue::types::path_t & dir,std::size_t ids,std::size_t perId,std::size_t maxFileSize,std::size_t itemSize){
+    Pool p(dir,maxFileSize);
+    std::string item(itemSize,'x');
+    for (std::size_t i=0;i<ids;i++) for (std::size_t k=0;k<perId;k++) p.push(item,i);
+}
+//! Maksymalny rozmiar pamięci procesu w KB (VmHWM - w przeciwieństwie do getrusage() nie jest dziedziczony przez execve() po procesie macierzystym).
+static std::size_t peakRss(){
+    std::ifstream f("/proc/self/status");
+    std::string line;
+    while (std::getline(f,line)) if (line.compare(0,6,"VmHWM:")==0) return std::stoul(line.substr(6));
+    return 0;
+}
+//! Pomiar w procesie potomnym - czas otwarcia (konstruktor i size()) albo czas do pierwszego odczytu (konstruktor i pop()).
+static int measure(const std::string & kind,const std::string & mode,const ict::queue::types::path_t & dir,std::size_t maxFileSize){
+    bench_clock_t::time_point start=bench_clock_t::now();
+    std::size_t size=0;
+    std::string c;
+    if (kind=="single"){
+        ict::queue::single q(dir,maxFileSize);
+        if (mode=="open") size=q.size(); else q.pop(c);
+    } else if (kind=="pool"){
+        ict::queue::pool p(dir,maxFileSize);
+        if (mode=="open") size=p.size(); else p.pop(c,0);
+    } else if (kind=="prioritized"){
+        ict::queue::prioritized p(dir,maxFileSize);
+        ict::queue::prioritized::priority_t priority;
+        if (mode=="open") size=p.size(); else p.pop(c,priority);
+    } else {
+        return -1;
+    }
+    bench_clock_t::duration elapsed=bench_clock_t::now()-start;
+    std::cout<<"\t"<<mode<<"="<<milliseconds(elapsed)<<"ms";
+    if (mode=="open") std::cout<<"\tsize="<<size;
+    std::cout<<"\t"<<mode<<"_peak_rss="<<peakRss()<<"KB"<<std::flush;
+    return 0;
+}
+static int run(const char * self,const std::string & kind,const std::string & mode,const ict::queue::types::path_t & dir,std::size_t maxFileSize){
+    int status=-1;
+    dropCache(dir);
+    pid_t pid=::fork();
+    if (pid==0){
+        const std::string size(std::to_string(maxFileSize));
+        ::execl(self,self,"--measure",kind.c_str(),mode.c_str(),dir.c_str(),size.c_str(),(char*)nullptr);
+        ::_exit(-1);
+    }
+    if (pid<0) return -1;
+    ::waitpid(pid,&status,0);
+    return (WIFEXITED(status)&&(WEXITSTATUS(status)==0))?0:-1;
+}
+static int scenario(const char * self,const std::string & kind,const ict::queue::types::path_t & dir,std::size_t maxFileSize,const std::string & description,const std::function<void()> & build){
+    bench_clock_t::time_point start;
+    std::filesystem::remove_all(dir);
+    std::filesystem::create_directories(dir);
+    start=bench_clock_t::now();
+    build();
+    std::cout<<kind<<"\t"<<description<<"\tmaxFileSize="<<maxFileSize<<"\tbuild="<<milliseconds(bench_clock_t::now()-start)<<"ms"<<std::flush;
+    if (run(self,kind,"open",dir,maxFileSize)||run(self,kind,"first_pop",dir,maxFileSize)){
+        std::cout<<std::endl;
+        std::cerr<<"Measurement failed!"<<std::endl;
+        return -2;
+    }
+    std::cout<<std::endl;
+    std::filesystem::remove_all(dir);
+    return 0;
+}
+//=================================================
+// Pomiar przepustowości kolejki single (--throughput) - liczby operacji w scenariuszach są proporcjonalne do --operations.
+//=================================================
+static void resetDir(const ict::queue::types::path_t & dir){
+    std::filesystem::remove_all(dir);
+    std::filesystem::create_directories(dir);
+}
+static std::size_t scaled(std::size_t operations,std::size_t divisor){
+    return std::max<std::size_t>(operations/divisor,1);
+}
+static void report(const std::string & description,std::size_t operations,const bench_clock_t::duration & elapsed){
+    const double ms=milliseconds(elapsed);
+    std::cout<<"single\t"<<description<<"\toperations="<<operations<<"\ttime="<<ms<<"ms\trate="<<((0<ms)?(operations*1000.0/ms):0.0)<<"/s"<<std::endl;
+}
+//! Zapis i odczyt pojedynczych elementów oraz zapis w paczkach.
+static void throughputPush(const ict::queue::types::path_t & dir,const bench_options_t & o){
+    const std::string item(o.item_size,'x');
+    std::string c;
+    resetDir(dir);
+    {
+        ict::queue::single q(dir);
+        bench_clock_t::time_point start=bench_clock_t::now();
+        for (std::size_t k=0;k<o.operations;k++) q.push(item);
+        for (std::size_t k=0;k<o.operations;k++) q.pop(c);
+        report("push+pop\titem_size="+std::to_string(item.size()),2*o.operations,bench_clock_t::now()-start);
+    }
+    resetDir(dir);
+    {
+        ict::queue::single q(dir);
+        std::vector<std::string> batch(1000,item);
+        bench_clock_t::time_point start=bench_clock_t::now();
+        for (std::size_t k=0;k<o.operations;k+=batch.size()){
+            if ((o.operations-k)<batch.size()) batch.resize(o.operations-k);
+            q.push_batch(batch);
+        }
+        for (std::size_t k=0;k<o.operations;k++) q.pop(c);
+        report("push_batch+pop\titem_size="+std::to_string(item.size())+"\tbatch=1000",2*o.operations,bench_clock_t::now()-start);
+    }
+}
+//! Zapis z wielu wątków (grupowe zatwierdzanie zapisów).
+static void throughputThreads(const ict::queue::types::path_t & dir,const bench_options_t & o){
+    const std::size_t threads=32;
+    const std::size_t max=scaled(o.operations,200);
+    const std::string item(o.item_size,'x');
+    std::vector<std::thread> producers;
+    resetDir(dir);
+    ict::queue::single q(dir);
+    bench_clock_t::time_point start=bench_clock_t::now();
+    for (std::size_t t=0;t<threads;t++) producers.emplace_back([&q,&item,max](){
+        for (std::size_t k=0;k<max;k++) q.push(item);
+    });
+    for (std::thread & t : producers) t.join();
+    report("push\tthreads="+std::to_string(threads)+"\titem_size="+std::to_string(item.size()),threads*max,bench_clock_t::now()-start);
+}
+struct durability_mode_t {
+    ict::queue::types::durability_t mode;
+    const char * name;
+};
+static const durability_mode_t durability_modes[]={
+    {ict::queue::types::buffered_durability,"buffered"},
+    {ict::queue::types::flush_durability,"flush"},
+    {ict::queue::types::fdatasync_durability,"fdatasync"},
+    {ict::queue::types::periodic_durability,"periodic"}
+};
+static std::size_t durabilityOperations(const bench_options_t & o,ict::queue::types::durability_t mode){
+    return (mode==ict::queue::types::fdatasync_durability)?scaled(o.operations,500):scaled(o.operations,10);
+}
+//! Tryby trwałości zapisu - małe i duże elementy.
+static void throughputDurability(const ict::queue::types::path_t & dir,const bench_options_t & o){
+    const std::string item(o.item_size,'x');
+    const std::string large(4000,'x');
+    std::string c;
+    for (const durability_mode_t & d : durability_modes){
+        ict::queue::types::options_t options;
+        const std::size_t max=durabilityOperations(o,d.mode);
+        options.durability=d.mode;
+        resetDir(dir);
+        {
+            ict::queue::single q(dir,1000000,0xffffffff,options);
+            bench_clock_t::time_point start=bench_clock_t::now();
+            for (std::size_t k=0;k<max;k++) q.push(item);
+            for (std::size_t k=0;k<max;k++) q.pop(c);
+            report("push+pop\tdurability="+std::string(d.name)+"\titem_size="+std::to_string(item.size()),2*max,bench_clock_t::now()-start);
+        }
+        {
+            ict::queue::single q(dir,1000000,0xffffffff,options);
+            const std::size_t n=scaled(max,10);
+            bench_clock_t::time_point start=bench_clock_t::now();
+            for (std::size_t k=0;k<n;k++) q.push(large);
+            report("push\tdurability="+std::string(d.name)+"\titem_size="+std::to_string(large.size()),n,bench_clock_t::now()-start);
+        }
+    }
+}
+//! Sposoby zapisu do plików - zapis synchronizowany z dyskiem po każdym elemencie.
+static void throughputBackends(const ict::queue::types::path_t & dir,const bench_options_t & o){
+    struct backend_t {
+        ict::queue::types::backend_t backend;
+        const char * name;
+    };
+    const backend_t backends[]={
+        {ict::queue::types::stream_backend,"stream"},
+        {ict::queue::types::descriptor_backend,"descriptor"},
+        {ict::queue::types::mmap_backend,"mmap"},
+        {ict::queue::types::uring_backend,"uring"}
+    };
+    const std::size_t max=scaled(o.operations,500);
+    const std::string large(4000,'x');
+    for (const backend_t & b : backends){
+        ict::queue::types::options_t options;
+        options.backend=b.backend;
+        options.durability=ict::queue::types::fdatasync_durability;
+        resetDir(dir);
+        ict::queue::single q(dir,1000000,0xffffffff,options);
+        bench_clock_t::time_point start=bench_clock_t::now();
+        for (std::size_t k=0;k<max;k++) q.push(large);
+        report("push\tbackend="+std::string(b.name)+"\tdurability=fdatasync\titem_size="+std::to_string(large.size()),max,bench_clock_t::now()-start);
+        if (q.size()!=max) throw std::runtime_error("Elements not written!");
+    }
+}
+//! Odczyt z potwierdzaniem co confirm_interval elementów.
+static void throughputConfirm(const ict::queue::types::path_t & dir,const bench_options_t & o){
+    const std::string item(o.item_size,'x');
+    const std::size_t intervals[]={0,100};
+    std::string c;
+    for (const durability_mode_t & d : durability_modes){
+        if ((d.mode!=ict::queue::types::flush_durability)&&(d.mode!=ict::queue::types::fdatasync_durability)) continue;
+        for (const std::size_t & interval : intervals){
+            ict::queue::types::options_t options;
+            const std::size_t max=durabilityOperations(o,d.mode);
+            options.durability=d.mode;
+            options.confirm_interval=interval;
+            resetDir(dir);
+            ict::queue::single q(dir,10000000,0xffffffff,options);
+            for (std::size_t k=0;k<max;k++) q.push(item);
+            bench_clock_t::time_point start=bench_clock_t::now();
+            for (std::size_t k=0;k<max;k++) q.pop(c);
+            report("pop\tdurability="+std::string(d.name)+"\tconfirm_interval="+std::to_string(interval)+"\titem_size="+std::to_string(item.size()),max,bench_clock_t::now()-start);
+        }
+    }
+}
+//! Odczyt z dysku (pliki usunięte z pamięci podręcznej systemu) - bufor odczytu i czytanie z wyprzedzeniem.
+static void throughputColdRead(const ict::queue::types::path_t & dir,const bench_options_t & o){
+    struct variant_t {
+        const char * name;
+        std::size_t read_buffer_size;
+        std::size_t read_ahead;
+    };
+    const variant_t variants[]={
+        {"read_buffer_size=0\tread_ahead=0",0,0},
+        {"read_buffer_size=65536\tread_ahead=0",1<<16,0},
+        {"read_buffer_size=65536\tread_ahead=4194304",1<<16,1<<22}
+    };
+    for (const variant_t & v : variants){
+        ict::queue::types::options_t options;
+        std::vector<std::string> output;
+        std::size_t count=0;
+        std::size_t n;
+        options.read_buffer_size=v.read_buffer_size;
+        options.read_ahead=v.read_ahead;
+        resetDir(dir);
+        buildSingle(dir,o.operations,1000000,o.item_size);
+        dropCache(dir);
+        ict::queue::single q(dir,1000000,0xffffffff,options);
+        bench_clock_t::time_point start=bench_clock_t::now();
+        do {
+            output.clear();
+            n=q.pop_n(output,1000);
+            count+=n;
+        } while (n);
+        report("cold pop_n\t"+std::string(v.name)+"\titem_size="+std::to_string(o.item_size),count,bench_clock_t::now()-start);
+    }
+}
+//! Odczyt dużych elementów - kopia (pop()) i widok pliku odwzorowanego w pamięci (pop_view()).
+static void throughputView(const ict::queue::types::path_t & dir,const bench_options_t & o){
+    const std::size_t max=scaled(o.operations,1000);
+    const std::string item(128000,'x');
+    std::string c;
+    resetDir(dir);
+    ict::queue::single q(dir);
+    for (std::size_t k=0;k<2*max;k++) q.push(item);
+    bench_clock_t::time_point start=bench_clock_t::now();
+    for (std::size_t k=0;k<max;k++) q.pop(c);
+    report("pop\titem_size="+std::to_string(item.size()),max,bench_clock_t::now()-start);
+    start=bench_clock_t::now();
+    for (std::size_t k=0;k<max;k++) q.pop_view().release();
+    report("pop_view\titem_size="+std::to_string(item.size()),max,bench_clock_t::now()-start);
+}
+//! Wartość z /proc/meminfo w KB (np. "Cached").
+static long long meminfo(const std::string & name){
+    std::ifstream f("/proc/meminfo");
+    std::string key;
+    long long value;
+    std::string unit;
+    while (f>>key>>value){
+        std::getline(f,unit);
+        if (key==(name+":")) return value;
+    }
+    return 0;
+}
+//! Zapis z pominięciem pamięci podręcznej systemu (direct_backend) - przepustowość i przyrost pamięci podręcznej w porównaniu z zapisem przez bufor.
+static void throughputDirect(const ict::queue::types::path_t & dir,const bench_options_t & o){
+    struct backend_t {
+        ict::queue::types::backend_t backend;
+        const char * name;
+    };
+    const backend_t backends[]={
+        {ict::queue::types::stream_backend,"stream"},
+        {ict::queue::types::direct_backend,"direct"}
+    };
+    const std::size_t max=scaled(o.operations,600);
+    const std::string large(128000,'x');
+    std::string c;
+    for (const backend_t & b : backends){
+        ict::queue::types::options_t options;
+        long long cached;
+        options.backend=b.backend;
+        options.durability=ict::queue::types::buffered_durability;
+        resetDir(dir);
+        {
+            ict::queue::single q(dir,10000000,0xffffffff,options);
+            bench_clock_t::time_point start;
+            cached=meminfo("Cached");
+            start=bench_clock_t::now();
+            for (std::size_t k=0;k<max;k++) q.push(large);
+            report("push\tbackend="+std::string(b.name)+"\titem_size="+std::to_string(large.size()),max,bench_clock_t::now()-start);
+        }
+        std::cout<<"single\tpage_cache\tbackend="<<b.name<<"\tgrowth="<<(meminfo("Cached")-cached)<<"KB"<<std::endl;
+        {
+            ict::queue::single q(dir,10000000,0xffffffff,options);
+            bench_clock_t::time_point start=bench_clock_t::now();
+            for (std::size_t k=0;k<max;k++) q.pop(c);
+            report("pop\tbackend="+std::string(b.name)+"\titem_size="+std::to_string(large.size()),max,bench_clock_t::now()-start);
+        }
+    }
+}
+//! Opóźnienie pop_wait() przy zapisie w innym procesie (inotify).
+static void latencyWait(const ict::queue::types::path_t & dir,const bench_options_t & o){
+    const std::size_t max=scaled(o.operations,5000);
+    long long total=0;
+    long long maximum=0;
+    std::size_t k=0;
+    std::string c;
+    resetDir(dir);
+    pid_t pid=::fork();
+    if (pid==0){
+        ict::queue::single q(dir);
+        std::this_thread::sleep_for(std::chrono::milliseconds(100));
+        for (std::size_t i=0;i<max;i++){
+            q.push(std::to_string(bench_clock_t::now().time_since_epoch().count()));
+            std::this_thread::sleep_for(std::chrono::milliseconds(2));
+        }
+        ::_exit(0);
+    }
+    if (pid<0) throw std::runtime_error("Fork failed!");
+    {
+        ict::queue::single q(dir);
+        for (;k<max;k++){
+            if (!q.pop_wait(c,std::chrono::seconds(5))) break;
+            const long long latency=bench_clock_t::now().time_since_epoch().count()-std::stoll(c);
+            total+=latency;
+            maximum=std::max(maximum,latency);
+        }
+    }
+    ::waitpid(pid,nullptr,0);
+    if (k!=max) throw std::runtime_error("Elements not received!");
+    std::cout<<"single\tpop_wait\toperations="<<max<<"\tlatency="<<milliseconds(bench_clock_t::duration(total/max))<<"ms\tmax_latency="<<milliseconds(bench_clock_t::duration(maximum))<<"ms"<<std::endl;
+}
+static void throughput(const ict::queue::types::path_t & dir,const bench_options_t & o){
+    throughputPush(dir,o);
+    throughputThreads(dir,o);
+    throughputDurability(dir,o);
+    throughputBackends(dir,o);
+    throughputDirect(dir,o);
+    throughputConfirm(dir,o);
+    throughputColdRead(dir,o);
+    throughputView(dir,o);
+    latencyWait(dir,o);
+    std::filesystem::remove_all(dir);
+}
+//=================================================
+int main(int argc,const char **argv){
+    if ((argc==6)&&(std::string(argv[1])=="--measure")) try {
+        return measure(argv[2],argv[3],argv[4],std::stoul(argv[5]));
+    } catch (const std::exception & e){
+        std::cerr<<e.what()<<std::endl;
+        return -2;
+    }
+    if (argc<2) {
+        std::cerr<<"Usage: "<<argv[0]<<" <dir> [--elements=1000,1000000,10000000] [--file-sizes=1000000,100000000] [--ids=10,1000,100000] [--per-id=10] [--item-size=100]"<<std::endl;
+        std::cerr<<"       "<<argv[0]<<" <dir> --throughput [--operations=1000000] [--item-size=100]"<<std::endl;
+        return -1;
+    } else try {
+        const ict::queue::types::path_t dir(argv[1]);
+        bench_options_t o;
+        char self[4096];
+        ssize_t n=::readlink("/proc/self/exe",self,sizeof(self)-1);
+        if (n<=0) throw std::runtime_error("Executable path not found!");
+        self[n]=0;
+        for (int k=2;k<argc;k++){
+            const std::string a(argv[k]);
+            const std::size_t e=a.find('=');
+            const std::string name(a.substr(0,e));
+            const std::string value((e==std::string::npos)?"":a.substr(e+1));
+            if (name=="--elements") o.elements=parseList(value);
+            else if (name=="--file-sizes") o.file_sizes=parseList(value);
+            else if (name=="--ids") o.ids=parseList(value);
+            else if (name=="--per-id") o.per_id=std::stoul(value);
+            else if (name=="--item-size") o.item_size=std::stoul(value);
+            else if (name=="--throughput") o.throughput=true;
+            else if (name=="--operations") o.operations=std::stoul(value);
+            else throw std::invalid_argument("Unknown option: "+a);
+        }
+        if (o.throughput){
+            throughput(dir,o);
+            return 0;
+        }
+        for (std::size_t fs : o.file_sizes){
+            for (std::size_t elements : o.elements){
+                if (scenario(self,"single",dir,fs,"elements="+std::to_string(elements),[&]{buildSingle(dir,elements,fs,o.item_size);})) return -2;
+            }
+            for (std::size_t ids : o.ids){
+                if (scenario(self,"pool",dir,fs,"ids="+std::to_string(ids)+"\tper_id="+std::to_string(o.per_id),[&]{
+                    buildPool<ict::queue::pool>(dir,ids,o.per_id,fs,o.item_size);
+                })) return -2;
+            }
+            // Priorytety są ograniczone do 256.
+            for (std::size_t ids : o.ids){
+                const std::size_t priorities=std::min<std::size_t>(ids,256);
+                if (scenario(self,"prioritized",dir,fs,"ids="+std::to_string(priorities)+"\tper_id="+std::to_string(o.per_id),[&]{
+                    buildPool<ict::queue::prioritized>(dir,priorities,o.per_id,fs,o.item_size);
+                })) return -2;
+                if (priorities<ids) break;
+            }
+        }
+    } catch (const std::exception & e){
+        std::cerr<<e.what()<<std::endl;
+        return -2;
+    }
+    return 0;
+}
+//===========================================
@@ -36,22 +36,99 @@ OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
 #include "dir-lock.hpp"
 #include <unistd.h>
 #include <fcntl.h>
+#include <cerrno>
 //============================================
 namespace ict { namespace  queue { namespace  dir {
 //============================================
 const std::string lockable::file_name="/dir.lock";
+//! 
+//! @brief Blokuje bajty pliku blokady odpowiadające zakresowi blokady (blokady OFD - należą do otwartego pliku, a nie do procesu,
+//!        więc zamknięcie innego deskryptora tego pliku w tym samym procesie ich nie zwalnia).
+//!        Bajt 0 jest blokowany wyłącznie dla całego katalogu (jak we wcześniejszych wersjach), a współdzielony dla stron kolejki,
+//!        które blokują wyłącznie bajt 1 (zapis) albo 2 (odczyt).
+//! 
+//! @param fd Deskryptor pliku blokady.
+//! @param range Zakres blokady.
+//! @param wait Czekanie na blokadę.
+//! @return true Zakres został zablokowany.
+//! @return false Zakres jest zablokowany przez inny proces lub obiekt (tylko bez czekania).
+//! 
+static bool lockRange(int fd,const lockable::range_t & range,bool wait){
+    struct flock l[2];
+    std::size_t count=0;
+    for (struct flock & i : l){
+        i.l_type=F_RDLCK;
+        i.l_whence=SEEK_SET;
+        i.l_start=0;
+        i.l_len=1;
+        i.l_pid=0;
+    }
+    switch (range){
+        case lockable::write_range:
+        case lockable::read_range:
+            l[1].l_type=F_WRLCK;
+            l[1].l_start=(range==lockable::write_range)?1:2;
+            count=2;
+            break;
+        case lockable::whole_range:
+        default:
+            l[0].l_type=F_WRLCK;
+            count=1;
+            break;
+    }
+    for (std::size_t k=0;k<count;k++){
+        int result;
+        do {
+            result=::fcntl(fd,wait?F_OFD_SETLKW:F_OFD_SETLK,&l[k]);
+        } while ((result!=0)&&(errno==EINTR));
+        if (result!=0) return false;
+    }
+    return true;
+}
+//! 
+//! @brief Zwalnia wszystkie zakresy blokady (zamknięcie deskryptora zwalnia blokady OFD tylko wtedy, gdy jest to ostatni
+//!        deskryptor otwartego pliku - np. nie został skopiowany przez fork()).
+//! 
+//! @param fd Deskryptor pliku blokady.
+//! 
+static void unlockRange(int fd){
+    struct flock l;
+    l.l_type=F_UNLCK;
+    l.l_whence=SEEK_SET;
+    l.l_start=0;
+    l.l_len=3;
+    l.l_pid=0;
+    ::fcntl(fd,F_OFD_SETLK,&l);
+}
 void lockable::lock(){
+    mutex.lock();
     if (fd<0){
         fd=::open(file_path.c_str(),O_RDWR|O_CREAT,S_IRUSR|S_IWUSR);
     }
     if (fd<0) return;
-    ::lockf(fd,F_LOCK,1);
+    lockRange(fd,range,true);
 }
-void lockable::unlock(){
-    if (fd<0) return;
-    ::lockf(fd,F_ULOCK,1);
+bool lockable::try_lock(){
+    if (!mutex.try_lock()) return false;
+    if (fd<0){
+        fd=::open(file_path.c_str(),O_RDWR|O_CREAT,S_IRUSR|S_IWUSR);
+    }
+    if (fd<0) return true;
+    if (lockRange(fd,range,false)) return true;
+    // Zwolnienie części zakresu zablokowanej przed niepowodzeniem.
+    unlockRange(fd);
     ::close(fd);
     fd=-1;
+    mutex.unlock();
+    return false;
+}
+void lockable::unlock(){
+    if (fd>=0) {
+        unlockRange(fd);
+        ::close(fd);
+        fd=-1;
+    }
+    mutex.unlock();
 }
 void lockable::readHash(hash & h) const {
     if (fd<0) return;
@@ -70,6 +147,9 @@ void lockable::writeHash(const hash & h)const {
 #include "test.hpp"
 #include <mutex>
 #include <filesystem>
+#include <thread>
+#include <unistd.h>
+#include <sys/wait.h>
 static ict::queue::types::path_t dirpath("/tmp/test-lock");
 REGISTER_TEST(dir_lock,tc1){
     int out=0;
@@ -87,5 +167,89 @@ REGISTER_TEST(dir_lock,tc1){
     std::filesystem::remove_all(dirpath);
     return(out);
 }
+REGISTER_TEST(dir_lock,tc2){
+    int out=0;
+    std::filesystem::create_directory(dirpath);
+    {
+        ict::queue::dir::lockable flock(dirpath);
+        if (!flock.try_lock()) out=-1;
+        if (out==0){
+            // Blokada w innym wątku tego samego procesu (mutex).
+            bool locked=true;
+            std::thread t([&]{
+                locked=flock.try_lock();
+                if (locked) flock.unlock();
+            });
+            t.join();
+            if (locked) out=-2;
+        }
+        if (out==0){
+            // Blokada w innym procesie (lockf).
+            pid_t pid=::fork();
+            if (pid==0){
+                ict::queue::dir::lockable other(dirpath);
+                bool locked=other.try_lock();
+                if (locked) other.unlock();
+                ::_exit(locked?1:0);
+            }
+            int status=-1;
+            ::waitpid(pid,&status,0);
+            if (!WIFEXITED(status)||(WEXITSTATUS(status)!=0)) out=-3;
+        }
+        flock.unlock();
+        if ((out==0)&&(!flock.try_lock())) out=-4;
+        if (out==0) flock.unlock();
+    }
+    std::filesystem::remove_all(dirpath);
+    return(out);
+}
+REGISTER_TEST(dir_lock,tc3){
+    int out=0;
+    std::filesystem::create_directory(dirpath);
+    {
+        ict::queue::dir::lockable whole(dirpath);
+        ict::queue::dir::lockable write(dirpath,ict::queue::dir::lockable::write_range);
+        ict::queue::dir::lockable read(dirpath,ict::queue::dir::lockable::read_range);
+        // Strona zapisu i strona odczytu nie wykluczają się nawzajem.
+        if (!write.try_lock()) out=-1;
+        if ((out==0)&&(!read.try_lock())) out=-2;
+        // Blokada całego katalogu wyklucza obie strony (także w tym samym procesie).
+        if ((out==0)&&whole.try_lock()) out=-3;
+        if (out==0){
+            // Druga blokada strony zapisu w innym procesie nie jest możliwa, a blokada strony odczytu - tak (po zwolnieniu).
+            pid_t pid=::fork();
+            if (pid==0){
+                ict::queue::dir::lockable other(dirpath,ict::queue::dir::lockable::write_range);
+                bool locked=other.try_lock();
+                if (locked) other.unlock();
+                ::_exit(locked?1:0);
+            }
+            int status=-1;
+            ::waitpid(pid,&status,0);
+            if (!WIFEXITED(status)||(WEXITSTATUS(status)!=0)) out=-4;
+        }
+        read.unlock();
+        if (out==0){
+            pid_t pid=::fork();
+            if (pid==0){
+                ict::queue::dir::lockable other(dirpath,ict::queue::dir::lockable::read_range);
+                bool locked=other.try_lock();
+                if (locked) other.unlock();
+                ::_exit(locked?0:1);
+            }
+            int status=-1;
+            ::waitpid(pid,&status,0);
+            if (!WIFEXITED(status)||(WEXITSTATUS(status)!=0)) out=-5;
+        }
+        write.unlock();
+        if ((out==0)&&(!whole.try_lock())) out=-6;
+        if (out==0){
+            if (read.try_lock()) out=-7;
+            whole.unlock();
+        }
+    }
+    std::filesystem::remove_all(dirpath);
+    return(out);
+}
 #endif
 //===========================================
\ No newline at end of file
@@ -36,18 +36,40 @@ OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
 #define _DIR_LOCK_HEADER
 //============================================
 #include <string>
+#include <mutex>
 #include "types.hpp"
 //============================================
 namespace ict { namespace  queue { namespace  dir {
 //===========================================
 class lockable{
+public:
+    //! Typ - Zakres blokady katalogu.
+    enum range_t {
+        //! Cały katalog (wyłącznie) - blokada zgodna z wcześniejszymi wersjami.
+        whole_range=0,
+        //! Strona zapisu kolejki - nie wyklucza blokady strony odczytu.
+        write_range,
+        //! Strona odczytu kolejki - nie wyklucza blokady strony zapisu.
+        read_range
+    };
 private:
     static const std::string file_name;
     const std::string file_path;
+    //! Zakres blokady.
+    const range_t range;
     int fd=-1;
+    //! Mutex (blokada pliku dotyczy całego procesu, więc wątki w ramach procesu trzeba blokować osobno).
+    std::mutex mutex;
 public:
-    lockable(const std::string & dirname):file_path(dirname+file_name){}
+    lockable(const std::string & dirname,const range_t & r=whole_range):file_path(dirname+file_name),range(r){}
     void lock();
+    //! 
+    //! @brief Próbuje zablokować katalog bez czekania (np. aby pominąć kolejkę używaną przez inny wątek lub proces).
+    //! 
+    //! @return true Katalog został zablokowany.
+    //! @return false Katalog jest zablokowany przez inny wątek lub proces.
+    //! 
+    bool try_lock();
     void unlock();
     struct hash {
         std::size_t size=-1;
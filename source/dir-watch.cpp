@@ -0,0 +1,117 @@
+//! @file
+//! @brief Directory watch module - Source file.
+//! @author Mariusz Ornowski (mariusz.ornowski@ict-project.pl)
+//! @date 2026
+//! @copyright ICT-Project Mariusz Ornowski (ict-project.pl)
+/* **************************************************************
+Copyright (c) 2026, ICT-Project Mariusz Ornowski (ict-project.pl)
+All rights reserved.
+
+Redistribution and use in source and binary forms, with or without
+modification, are permitted provided that the following conditions
+are met:
+
+1. Redistributions of source code must retain the above copyright
+notice, this list of conditions and the following disclaimer.
+2. Redistributions in binary form must reproduce the above copyright
+notice, this list of conditions and the following disclaimer in the
+documentation and/or other materials provided with the distribution.
+3. Neither the name of the ICT-Project Mariusz Ornowski nor the names
+of its contributors may be used to endorse or promote products
+derived from this software without specific prior written permission.
+
+THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+"AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR
+A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT
+HOLDER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,
+SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT
+LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,
+DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY
+THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+(INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+**************************************************************/
+//============================================
+#include "dir-watch.hpp"
+#include <cstdint>
+#include <cerrno>
+#include <unistd.h>
+#include <poll.h>
+#include <sys/inotify.h>
+#include <sys/eventfd.h>
+//============================================
+namespace ict { namespace  queue { namespace  dir {
+//============================================
+watcher::~watcher(){
+    if (thread.joinable()){
+        const std::uint64_t v=1;
+        // Wątek używa obiektu i deskryptorów, więc musi zakończyć się przed ich zamknięciem (zapis jest ponawiany po przerwaniu przez sygnał).
+        while ((::write(stop_fd,&v,sizeof(v))<0)&&(errno==EINTR)){}
+        thread.join();
+    }
+    if (0<=fd) ::close(fd);
+    if (0<=stop_fd) ::close(stop_fd);
+}
+bool watcher::start(const std::function<void()> & callback){
+    std::lock_guard<std::mutex> lock(mutex);
+    if (started) return available;
+    started=true;
+    fd=::inotify_init1(IN_NONBLOCK|IN_CLOEXEC);
+    if (fd<0) return false;
+    stop_fd=::eventfd(0,EFD_CLOEXEC);
+    // Zmiany zawartości plików (zapis) i nowe pliki w katalogu.
+    if ((stop_fd<0)||(::inotify_add_watch(fd,dir_path.c_str(),IN_MODIFY|IN_CREATE|IN_MOVED_TO)<0)){
+        ::close(fd);
+        fd=-1;
+        return false;
+    }
+    thread=std::thread(&watcher::run,this,callback);
+    available=true;
+    return true;
+}
+void watcher::run(const std::function<void()> callback){
+    alignas(struct inotify_event) char buffer[4096];
+    struct pollfd fds[2]={{fd,POLLIN,0},{stop_fd,POLLIN,0}};
+    while (true){
+        if (::poll(fds,2,-1)<0) continue;
+        if (fds[1].revents) return;
+        if (fds[0].revents){
+            while (0<::read(fd,buffer,sizeof(buffer))){}
+            callback();
+        }
+    }
+}
+//===========================================
+} } }
+//===========================================
+#ifdef ENABLE_TESTING
+#include "test.hpp"
+#include <filesystem>
+#include <fstream>
+#include <atomic>
+#include <chrono>
+
+static ict::queue::types::path_t dirpath("/tmp/test-dirwatch");
+REGISTER_TEST(dirwatch,tc1){
+    int out=0;
+    std::filesystem::remove_all(dirpath);
+    std::filesystem::create_directory(dirpath);
+    {
+        std::atomic_size_t count(0);
+        ict::queue::dir::watcher w(dirpath);
+        if (!w.start([&count]{count++;})){
+            std::cerr<<"inotify not available"<<std::endl;
+        } else {
+            std::ofstream f(dirpath+"/test.dat",std::ios::out|std::ios::binary);
+            f<<"Ala ma kota!";
+            f.flush();
+            for (std::size_t k=0;(k<1000)&&(count==0);k++) std::this_thread::sleep_for(std::chrono::milliseconds(1));
+            if (count==0) out=1;
+        }
+    }
+    std::filesystem::remove_all(dirpath);
+    return out;
+}
+#endif
+//===========================================
@@ -0,0 +1,92 @@
+//! @file
+//! @brief Directory watch module - header file.
+//! @author Mariusz Ornowski (mariusz.ornowski@ict-project.pl)
+//! @date 2026
+//! @copyright ICT-Project Mariusz Ornowski (ict-project.pl)
+/* **************************************************************
+Copyright (c) 2026, ICT-Project Mariusz Ornowski (ict-project.pl)
+All rights reserved.
+
+Redistribution and use in source and binary forms, with or without
+modification, are permitted provided that the following conditions
+are met:
+
+1. Redistributions of source code must retain the above copyright
+notice, this list of conditions and the following disclaimer.
+2. Redistributions in binary form must reproduce the above copyright
+notice, this list of conditions and the following disclaimer in the
+documentation and/or other materials provided with the distribution.
+3. Neither the name of the ICT-Project Mariusz Ornowski nor the names
+of its contributors may be used to endorse or promote products
+derived from this software without specific prior written permission.
+
+THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+"AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR
+A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT
+HOLDER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,
+SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT
+LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,
+DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY
+THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+(INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+**************************************************************/
+#ifndef _DIR_WATCH_HEADER
+#define _DIR_WATCH_HEADER
+//============================================
+#include <string>
+#include <mutex>
+#include <thread>
+#include <functional>
+#include "types.hpp"
+//============================================
+namespace ict { namespace  queue { namespace  dir {
+//===========================================
+//! Obserwacja zmian plików w katalogu (inotify) - wątek, który wywołuje podaną funkcję po każdej zmianie.
+class watcher{
+private:
+    //! Ścieżka do katalogu.
+    const std::string dir_path;
+    //! Deskryptor inotify.
+    int fd=-1;
+    //! Deskryptor (eventfd) do zatrzymania wątku.
+    int stop_fd=-1;
+    //! Wątek obserwujący katalog.
+    std::thread thread;
+    //! Mutex dla uruchomienia obserwacji.
+    std::mutex mutex;
+    //! Informacja, czy była próba uruchomienia obserwacji.
+    bool started=false;
+    //! Informacja, czy obserwacja działa.
+    bool available=false;
+    //! 
+    //! @brief Pętla wątku obserwującego katalog.
+    //! 
+    //! @param callback Funkcja wywoływana po zmianie plików w katalogu.
+    //! 
+    void run(const std::function<void()> callback);
+public:
+    //! 
+    //! @brief Konstruktor.
+    //! 
+    //! @param dirname Ścieżka do katalogu.
+    //! 
+    watcher(const std::string & dirname):dir_path(dirname){}
+    //! 
+    //! @brief Destruktor (zatrzymuje wątek obserwujący katalog).
+    //! 
+    ~watcher();
+    //! 
+    //! @brief Uruchamia obserwację katalogu (tylko za pierwszym razem, kolejne wywołania zwracają tylko wynik).
+    //! 
+    //! @param callback Funkcja wywoływana (w wątku obserwującym) po zmianie plików w katalogu.
+    //! @return true Obserwacja działa.
+    //! @return false Obserwacja nie jest dostępna (np. brak inotify).
+    //! 
+    bool start(const std::function<void()> & callback);
+};
+//===========================================
+} } }
+//============================================
+#endif
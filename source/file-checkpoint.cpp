@@ -0,0 +1,145 @@
+//! @file
+//! @brief File checkpoint module - Source file.
+//! @author Mariusz Ornowski (mariusz.ornowski@ict-project.pl)
+//! @date 2026
+//! @copyright ICT-Project Mariusz Ornowski (ict-project.pl)
+/* **************************************************************
+Copyright (c) 2026, ICT-Project Mariusz Ornowski (ict-project.pl)
+All rights reserved.
+
+Redistribution and use in source and binary forms, with or without
+modification, are permitted provided that the following conditions
+are met:
+
+1. Redistributions of source code must retain the above copyright
+notice, this list of conditions and the following disclaimer.
+2. Redistributions in binary form must reproduce the above copyright
+notice, this list of conditions and the following disclaimer in the
+documentation and/or other materials provided with the distribution.
+3. Neither the name of the ICT-Project Mariusz Ornowski nor the names
+of its contributors may be used to endorse or promote products
+derived from this software without specific prior written permission.
+
+THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+"AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR
+A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT
+HOLDER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,
+SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT
+LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,
+DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY
+THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+(INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+**************************************************************/
+//============================================
+#include "file-checkpoint.hpp"
+#include <unistd.h>
+#include <fcntl.h>
+//============================================
+namespace ict { namespace  queue { namespace  file {
+//============================================
+const std::string checkpoint::file_name="/size.checkpoint";
+std::uint64_t checkpoint::checksum(const slot_t & slot){
+    // FNV-1a
+    const std::uint64_t data[6]={slot.sequence,slot.state.file,slot.state.inode,slot.state.offset,slot.state.size,slot.state.count};
+    const unsigned char * p=(const unsigned char *)data;
+    std::uint64_t output=0xcbf29ce484222325ULL;
+    for (std::size_t k=0;k<sizeof(data);k++){
+        output^=p[k];
+        output*=0x100000001b3ULL;
+    }
+    return output;
+}
+bool checkpoint::read(int fd,slot_t & slot){
+    slot_t slots[2];
+    bool found=false;
+    ssize_t s=::pread(fd,slots,sizeof(slots),0);
+    for (std::size_t k=0;(k+1)*sizeof(slot_t)<=(std::size_t)((s<0)?0:s);k++){
+        if (slots[k].sequence&&(slots[k].checksum==checksum(slots[k]))){
+            if ((!found)||(slot.sequence<slots[k].sequence)){
+                slot=slots[k];
+                found=true;
+            }
+        }
+    }
+    return found;
+}
+bool checkpoint::load(state_t & state) const{
+    slot_t slot;
+    int fd=::open(file_path.c_str(),O_RDONLY|O_CLOEXEC);
+    if (fd<0) return false;
+    bool found=read(fd,slot);
+    ::close(fd);
+    if (found) state=slot.state;
+    return found;
+}
+bool checkpoint::store(const state_t & state){
+    slot_t slot;
+    bool out;
+    int fd=::open(file_path.c_str(),O_RDWR|O_CREAT|O_CLOEXEC,0644);
+    if (fd<0) return false;
+    if (!read(fd,slot)) slot.sequence=0;
+    slot.sequence++;
+    slot.state=state;
+    slot.checksum=checksum(slot);
+    // Zapis do slotu, który nie zawiera ostatniego zapisu - przerwany zapis nie niszczy poprzedniego stanu.
+    out=(::pwrite(fd,&slot,sizeof(slot_t),(slot.sequence%2)*sizeof(slot_t))==(ssize_t)sizeof(slot_t));
+    ::close(fd);
+    return out;
+}
+//===========================================
+} } }
+//===========================================
+#ifdef ENABLE_TESTING
+#include "test.hpp"
+#include <filesystem>
+#include <fstream>
+
+static ict::queue::types::path_t dirpath("/tmp/test-filecheckpoint");
+REGISTER_TEST(filecheckpoint,tc1){
+    int out=0;
+    std::filesystem::remove_all(dirpath);
+    std::filesystem::create_directory(dirpath);
+    {
+        ict::queue::file::checkpoint c(dirpath);
+        ict::queue::file::checkpoint::state_t s;
+        if (c.load(s)) out=1;
+        for (std::uint64_t k=1;(out==0)&&(k<=5);k++){
+            s.file=k;
+            s.inode=10*k;
+            s.offset=100*k;
+            s.size=k;
+            s.count=2*k;
+            if (!c.store(s)) out=2;
+        }
+    }
+    if (out==0) {
+        ict::queue::file::checkpoint c(dirpath);
+        ict::queue::file::checkpoint::state_t s;
+        if (!c.load(s)){
+            out=3;
+        } else if ((s.file!=5)||(s.inode!=50)||(s.offset!=500)||(s.size!=5)||(s.count!=10)){
+            out=4;
+        }
+    }
+    if (out==0) {
+        // Uszkodzenie ostatniego zapisu (slot 1) - powinien zostać odczytany poprzedni stan.
+        std::fstream f(dirpath+"/size.checkpoint",std::ios::in|std::ios::out|std::ios::binary);
+        f.seekp(56+8);
+        f.put('x');
+    }
+    if (out==0) {
+        ict::queue::file::checkpoint c(dirpath);
+        ict::queue::file::checkpoint::state_t s;
+        if (!c.load(s)){
+            out=5;
+        } else if ((s.file!=4)||(s.offset!=400)||(s.size!=4)){
+            out=6;
+        }
+    }
+    std::filesystem::remove_all(dirpath);
+    return out;
+}
+#endif
+//===========================================
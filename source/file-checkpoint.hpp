@@ -0,0 +1,119 @@
+//! @file
+//! @brief File checkpoint module - header file.
+//! @author Mariusz Ornowski (mariusz.ornowski@ict-project.pl)
+//! @date 2026
+//! @copyright ICT-Project Mariusz Ornowski (ict-project.pl)
+/* **************************************************************
+Copyright (c) 2026, ICT-Project Mariusz Ornowski (ict-project.pl)
+All rights reserved.
+
+Redistribution and use in source and binary forms, with or without
+modification, are permitted provided that the following conditions
+are met:
+
+1. Redistributions of source code must retain the above copyright
+notice, this list of conditions and the following disclaimer.
+2. Redistributions in binary form must reproduce the above copyright
+notice, this list of conditions and the following disclaimer in the
+documentation and/or other materials provided with the distribution.
+3. Neither the name of the ICT-Project Mariusz Ornowski nor the names
+of its contributors may be used to endorse or promote products
+derived from this software without specific prior written permission.
+
+THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+"AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR
+A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT
+HOLDER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,
+SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT
+LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,
+DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY
+THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+(INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+**************************************************************/
+#ifndef _FILE_CHECKPOINT_HEADER
+#define _FILE_CHECKPOINT_HEADER
+//============================================
+#include "types.hpp"
+#include <string>
+#include <cstdint>
+//============================================
+namespace ict { namespace  queue { namespace  file {
+//===========================================
+//! Plik punktu kontrolnego - stan odczytu rekordów pliku do zapisu (rozmiar kolejki) do podanej pozycji, tak aby przy otwarciu
+//! kolejki odczytywać tylko rekordy zapisane później (dwa sloty z sumą kontrolną, zapisywane na zmianę).
+class checkpoint {
+public:
+    //! Typ - Stan pliku do zapisu.
+    struct state_t {
+        //! Numer pliku do zapisu.
+        std::uint64_t file=0;
+        //! Numer i-węzła pliku do zapisu (plik o tym samym numerze mógł zostać utworzony ponownie).
+        std::uint64_t inode=0;
+        //! Pozycja w pliku (początek rekordu), do której stan jest znany.
+        std::uint64_t offset=0;
+        //! Rozmiar kolejki według rekordów pliku do tej pozycji (bez uwzględnienia pliku kursora).
+        std::uint64_t size=0;
+        //! Licznik odczytanych elementów z rekordu read_count_record.
+        std::uint64_t count=0;
+    };
+private:
+    //! Typ - Slot zapisany w pliku punktu kontrolnego.
+    struct slot_t {
+        //! Numer kolejny zapisu (0 - slot pusty).
+        std::uint64_t sequence;
+        //! Stan pliku do zapisu.
+        state_t state;
+        //! Suma kontrolna.
+        std::uint64_t checksum;
+    };
+    //! Nazwa pliku punktu kontrolnego.
+    static const std::string file_name;
+    //! Ścieżka do pliku punktu kontrolnego.
+    const std::string file_path;
+    //! 
+    //! @brief Wylicza sumę kontrolną slotu.
+    //! 
+    //! @param slot Slot.
+    //! @return Suma kontrolna.
+    //! 
+    static std::uint64_t checksum(const slot_t & slot);
+    //! 
+    //! @brief Odczytuje z pliku poprawny slot z najnowszym zapisem.
+    //! 
+    //! @param fd Deskryptor pliku.
+    //! @param slot Odczytany slot.
+    //! @return true Slot został odczytany.
+    //! @return false Plik nie zawiera poprawnego slotu.
+    //! 
+    static bool read(int fd,slot_t & slot);
+public:
+    //! 
+    //! @brief Konstruktor.
+    //! 
+    //! @param dirname Ścieżka do katalogu z plikami kolejki.
+    //! 
+    checkpoint(const ict::queue::types::path_t & dirname):file_path(dirname+file_name){}
+    //! 
+    //! @brief Odczytuje stan z pliku punktu kontrolnego.
+    //! 
+    //! @param state Odczytany stan.
+    //! @return true Stan został odczytany.
+    //! @return false Plik nie istnieje lub nie zawiera poprawnego slotu.
+    //! 
+    bool load(state_t & state) const;
+    //! 
+    //! @brief Zapisuje stan w pliku punktu kontrolnego (w slocie, który nie zawiera ostatniego zapisu).
+    //!        Punkt kontrolny służy tylko przyspieszeniu otwarcia kolejki, więc błąd zapisu nie jest zgłaszany.
+    //! 
+    //! @param state Stan do zapisania.
+    //! @return true Stan został zapisany.
+    //! @return false Stan nie został zapisany.
+    //! 
+    bool store(const state_t & state);
+};
+//===========================================
+} } }
+//============================================
+#endif
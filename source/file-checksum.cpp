@@ -0,0 +1,196 @@
+//! @file
+//! @brief File checksum module - Source file.
+//! @author Mariusz Ornowski (mariusz.ornowski@ict-project.pl)
+//! @date 2026
+//! @copyright ICT-Project Mariusz Ornowski (ict-project.pl)
+/* **************************************************************
+Copyright (c) 2026, ICT-Project Mariusz Ornowski (ict-project.pl)
+All rights reserved.
+
+Redistribution and use in source and binary forms, with or without
+modification, are permitted provided that the following conditions
+are met:
+
+1. Redistributions of source code must retain the above copyright
+notice, this list of conditions and the following disclaimer.
+2. Redistributions in binary form must reproduce the above copyright
+notice, this list of conditions and the following disclaimer in the
+documentation and/or other materials provided with the distribution.
+3. Neither the name of the ICT-Project Mariusz Ornowski nor the names
+of its contributors may be used to endorse or promote products
+derived from this software without specific prior written permission.
+
+THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+"AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR
+A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT
+HOLDER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,
+SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT
+LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,
+DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY
+THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+(INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+**************************************************************/
+//============================================
+#include "file-checksum.hpp"
+#include <cstring>
+#if defined(__x86_64__)||defined(__i386__)
+#include <nmmintrin.h>
+#elif defined(__aarch64__)
+#include <arm_acle.h>
+#include <sys/auxv.h>
+#include <asm/hwcap.h>
+#endif
+//============================================
+namespace ict { namespace  queue { namespace  file {
+//============================================
+//! Tablice metody slicing-by-8 (wielomian 0x82f63b78 - odwrócony 0x1edc6f41).
+struct crc32c_tables_t {
+    std::uint32_t table[8][256];
+    crc32c_tables_t(){
+        for (std::uint32_t n=0;n<256;n++){
+            std::uint32_t c=n;
+            for (int k=0;k<8;k++) c=(c&1)?((c>>1)^0x82f63b78):(c>>1);
+            table[0][n]=c;
+        }
+        for (std::uint32_t n=0;n<256;n++){
+            for (int k=1;k<8;k++) table[k][n]=(table[k-1][n]>>8)^table[0][table[k-1][n]&0xff];
+        }
+    }
+};
+static const crc32c_tables_t crc32c_tables;
+//! 
+//! @brief Odczytuje 8 bajtów jako liczbę little-endian (tablice slicing-by-8 przetwarzają bajty od najmłodszego, niezależnie od procesora).
+//! 
+//! @param p Wskaźnik do danych.
+//! @return Liczba.
+//! 
+static inline std::uint64_t loadLittleEndian(const unsigned char * p){
+#if defined(__BYTE_ORDER__)&&(__BYTE_ORDER__==__ORDER_LITTLE_ENDIAN__)
+    std::uint64_t v;
+    std::memcpy(&v,p,8);
+    return v;
+#else
+    return ((std::uint64_t)p[0])|((std::uint64_t)p[1]<<8)|((std::uint64_t)p[2]<<16)|((std::uint64_t)p[3]<<24)|
+        ((std::uint64_t)p[4]<<32)|((std::uint64_t)p[5]<<40)|((std::uint64_t)p[6]<<48)|((std::uint64_t)p[7]<<56);
+#endif
+}
+std::uint32_t crc32c_portable(std::uint32_t crc,const void * data,std::size_t size){
+    const std::uint32_t (&t)[8][256]=crc32c_tables.table;
+    const unsigned char * p=(const unsigned char *)data;
+    crc=~crc;
+    for (;size&&(((std::uintptr_t)p)&7);size--) crc=(crc>>8)^t[0][(crc^*p++)&0xff];
+    for (;8<=size;size-=8,p+=8){
+        const std::uint64_t v=loadLittleEndian(p)^crc;
+        crc=t[7][v&0xff]^t[6][(v>>8)&0xff]^t[5][(v>>16)&0xff]^t[4][(v>>24)&0xff]^
+            t[3][(v>>32)&0xff]^t[2][(v>>40)&0xff]^t[1][(v>>48)&0xff]^t[0][v>>56];
+    }
+    for (;size;size--) crc=(crc>>8)^t[0][(crc^*p++)&0xff];
+    return ~crc;
+}
+#if defined(__x86_64__)
+__attribute__((target("sse4.2"))) static std::uint32_t crc32c_instructions(std::uint32_t crc,const void * data,std::size_t size){
+    const unsigned char * p=(const unsigned char *)data;
+    std::uint64_t c=~crc;
+    for (;size&&(((std::uintptr_t)p)&7);size--) c=_mm_crc32_u8(c,*p++);
+    for (;8<=size;size-=8,p+=8){
+        std::uint64_t v;
+        std::memcpy(&v,p,8);
+        c=_mm_crc32_u64(c,v);
+    }
+    for (;size;size--) c=_mm_crc32_u8(c,*p++);
+    return ~(std::uint32_t)c;
+}
+static bool crc32c_supported(){
+    // Wywoływane podczas inicjacji zmiennych statycznych (przed main()).
+    __builtin_cpu_init();
+    return __builtin_cpu_supports("sse4.2");
+}
+#elif defined(__aarch64__)
+__attribute__((target("+crc"))) static std::uint32_t crc32c_instructions(std::uint32_t crc,const void * data,std::size_t size){
+    const unsigned char * p=(const unsigned char *)data;
+    crc=~crc;
+    for (;size&&(((std::uintptr_t)p)&7);size--) crc=__crc32cb(crc,*p++);
+    for (;8<=size;size-=8,p+=8){
+        crc=__crc32cd(crc,loadLittleEndian(p));
+    }
+    for (;size;size--) crc=__crc32cb(crc,*p++);
+    return ~crc;
+}
+static bool crc32c_supported(){
+    return getauxval(AT_HWCAP)&HWCAP_CRC32;
+}
+#else
+static std::uint32_t crc32c_instructions(std::uint32_t crc,const void * data,std::size_t size){
+    return crc32c_portable(crc,data,size);
+}
+static bool crc32c_supported(){
+    return false;
+}
+#endif
+//! Funkcja wyliczająca sumę kontrolną (wybierana raz, przy starcie programu).
+static std::uint32_t (* const crc32c_function)(std::uint32_t,const void *,std::size_t)=crc32c_supported()?crc32c_instructions:crc32c_portable;
+std::uint32_t crc32c(std::uint32_t crc,const void * data,std::size_t size){
+    return crc32c_function(crc,data,size);
+}
+bool crc32c_hardware(){
+    return crc32c_function!=crc32c_portable;
+}
+std::uint32_t checksum(const ict::queue::types::const_buffer_t * buffers,const std::size_t & count,const std::uint64_t & size){
+    std::uint32_t crc=crc32c(0,&size,sizeof(size));
+    for (std::size_t k=0;k<count;k++) if (buffers[k].size) crc=crc32c(crc,buffers[k].data,buffers[k].size);
+    return crc;
+}
+//===========================================
+} } }
+//===========================================
+#ifdef ENABLE_TESTING
+#include "test.hpp"
+#include <string>
+#include <vector>
+#include <chrono>
+
+REGISTER_TEST(filechecksum,tc1){
+    int out=0;
+    const std::string check("123456789");
+    std::string data;
+    for (std::size_t k=0;k<100000;k++) data+=(char)(k*31+k/7);
+    std::cout<<"hardware="<<ict::queue::file::crc32c_hardware()<<std::endl;
+    // Wartość kontrolna CRC32C.
+    if (ict::queue::file::crc32c(0,check.data(),check.size())!=0xe3069283) out=1;
+    if ((out==0)&&(ict::queue::file::crc32c_portable(0,check.data(),check.size())!=0xe3069283)) out=2;
+    if ((out==0)&&(ict::queue::file::crc32c(0,nullptr,0)!=0)) out=3;
+    // Różne wyrównania i długości oraz wyliczanie w częściach.
+    for (std::size_t offset=0;(out==0)&&(offset<9);offset++){
+        for (std::size_t size=0;(out==0)&&(size<100);size++){
+            const std::uint32_t a=ict::queue::file::crc32c(0,data.data()+offset,size);
+            const std::uint32_t b=ict::queue::file::crc32c_portable(0,data.data()+offset,size);
+            const std::uint32_t c=ict::queue::file::crc32c(ict::queue::file::crc32c(0,data.data()+offset,size/3),data.data()+offset+size/3,size-size/3);
+            if ((a!=b)||(a!=c)){
+                std::cerr<<"offset="<<offset<<" size="<<size<<std::endl;
+                out=4;
+            }
+        }
+    }
+    if (out==0){
+        const ict::queue::types::const_buffer_t buffers[2]={{data.data(),10},{data.data()+10,90}};
+        std::uint64_t size=100;
+        if (ict::queue::file::checksum(buffers,2,size)!=ict::queue::file::crc32c(ict::queue::file::crc32c(0,&size,sizeof(size)),data.data(),100)) out=5;
+    }
+    if (out==0){
+        std::uint32_t crc=0;
+        auto start=std::chrono::high_resolution_clock::now();
+        for (std::size_t k=0;k<1000;k++) crc=ict::queue::file::crc32c(crc,data.data(),data.size());
+        auto elapsed=std::chrono::high_resolution_clock::now()-start;
+        std::cout<<"crc32c: rate="<<(1000.0*data.size()/std::chrono::duration_cast<std::chrono::microseconds>(elapsed).count())<<" MB/s ("<<crc<<")"<<std::endl;
+        crc=0;
+        start=std::chrono::high_resolution_clock::now();
+        for (std::size_t k=0;k<1000;k++) crc=ict::queue::file::crc32c_portable(crc,data.data(),data.size());
+        elapsed=std::chrono::high_resolution_clock::now()-start;
+        std::cout<<"crc32c_portable: rate="<<(1000.0*data.size()/std::chrono::duration_cast<std::chrono::microseconds>(elapsed).count())<<" MB/s ("<<crc<<")"<<std::endl;
+    }
+    return out;
+}
+#endif
+//===========================================
@@ -0,0 +1,81 @@
+//! @file
+//! @brief File checksum module - header file.
+//! @author Mariusz Ornowski (mariusz.ornowski@ict-project.pl)
+//! @date 2026
+//! @copyright ICT-Project Mariusz Ornowski (ict-project.pl)
+/* **************************************************************
+Copyright (c) 2026, ICT-Project Mariusz Ornowski (ict-project.pl)
+All rights reserved.
+
+Redistribution and use in source and binary forms, with or without
+modification, are permitted provided that the following conditions
+are met:
+
+1. Redistributions of source code must retain the above copyright
+notice, this list of conditions and the following disclaimer.
+2. Redistributions in binary form must reproduce the above copyright
+notice, this list of conditions and the following disclaimer in the
+documentation and/or other materials provided with the distribution.
+3. Neither the name of the ICT-Project Mariusz Ornowski nor the names
+of its contributors may be used to endorse or promote products
+derived from this software without specific prior written permission.
+
+THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+"AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR
+A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT
+HOLDER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,
+SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT
+LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,
+DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY
+THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+(INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+**************************************************************/
+#ifndef _FILE_CHECKSUM_HEADER
+#define _FILE_CHECKSUM_HEADER
+//============================================
+#include "types.hpp"
+#include <cstdint>
+//============================================
+namespace ict { namespace  queue { namespace  file {
+//===========================================
+//! 
+//! @brief Wylicza sumę kontrolną CRC32C (Castagnoli) - instrukcjami procesora (SSE4.2 lub ARMv8 CRC), jeśli są dostępne,
+//!        albo metodą slicing-by-8.
+//! 
+//! @param crc Suma kontrolna wcześniejszych danych (0 na początku).
+//! @param data Dane.
+//! @param size Rozmiar danych w bajtach.
+//! @return Suma kontrolna.
+//! 
+std::uint32_t crc32c(std::uint32_t crc,const void * data,std::size_t size);
+//! 
+//! @brief Wylicza sumę kontrolną CRC32C metodą slicing-by-8 (bez instrukcji procesora).
+//! 
+//! @param crc Suma kontrolna wcześniejszych danych (0 na początku).
+//! @param data Dane.
+//! @param size Rozmiar danych w bajtach.
+//! @return Suma kontrolna.
+//! 
+std::uint32_t crc32c_portable(std::uint32_t crc,const void * data,std::size_t size);
+//! 
+//! @brief Sprawdza, czy suma kontrolna CRC32C jest wyliczana instrukcjami procesora.
+//! 
+//! @return true Instrukcje procesora są używane.
+//! @return false Używana jest metoda slicing-by-8.
+//! 
+bool crc32c_hardware();
+//! 
+//! @brief Wylicza sumę kontrolną elementu zapisywaną w rekordzie payload_checksum_record - CRC32C rozmiaru danych (8 bajtów) i danych.
+//! 
+//! @param buffers Bufory z danymi elementu.
+//! @param count Liczba buforów.
+//! @param size Rozmiar danych elementu (suma rozmiarów buforów).
+//! @return Suma kontrolna.
+//! 
+std::uint32_t checksum(const ict::queue::types::const_buffer_t * buffers,const std::size_t & count,const std::uint64_t & size);
+//===========================================
+} } }
+//============================================
+#endif
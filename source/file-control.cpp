@@ -0,0 +1,237 @@
+//! @file
+//! @brief File control module - Source file.
+//! @author Mariusz Ornowski (mariusz.ornowski@ict-project.pl)
+//! @date 2026
+//! @copyright ICT-Project Mariusz Ornowski (ict-project.pl)
+/* **************************************************************
+Copyright (c) 2026, ICT-Project Mariusz Ornowski (ict-project.pl)
+All rights reserved.
+
+Redistribution and use in source and binary forms, with or without
+modification, are permitted provided that the following conditions
+are met:
+
+1. Redistributions of source code must retain the above copyright
+notice, this list of conditions and the following disclaimer.
+2. Redistributions in binary form must reproduce the above copyright
+notice, this list of conditions and the following disclaimer in the
+documentation and/or other materials provided with the distribution.
+3. Neither the name of the ICT-Project Mariusz Ornowski nor the names
+of its contributors may be used to endorse or promote products
+derived from this software without specific prior written permission.
+
+THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+"AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR
+A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT
+HOLDER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,
+SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT
+LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,
+DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY
+THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+(INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+**************************************************************/
+//============================================
+#include "file-control.hpp"
+#include <unistd.h>
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+//============================================
+namespace ict { namespace  queue { namespace  file {
+//============================================
+const std::string control::file_name="/dir.lock";
+//! Pozycja bloku kontrolnego w pliku blokady (za skrótem puli kolejek, zob. ict::queue::dir::lockable::writeHash()).
+static const std::size_t block_offset=64;
+static_assert(std::atomic_uint64_t::is_always_lock_free,"ict::queue::file::control counter must be lock-free!");
+//! Liczba prób odczytu stanu, gdy w trakcie odczytu zmienił się licznik wszystkich zmian (zob. control::state()).
+static const std::size_t state_attempts=3;
+struct control::block_t {
+    //! Typ - Część bloku kontrolnego.
+    struct part_block_t {
+        //! Licznik zmian w plikach kolejki, których dotyczy część.
+        std::atomic_uint64_t generation;
+        //! Wartość licznika zmian powiększona o 1, przy której opublikowana wartość jest aktualna (0 - wartość nie została opublikowana).
+        std::atomic_uint64_t published;
+        //! Opublikowana wartość.
+        std::atomic_uint64_t value;
+    };
+    //! Licznik wszystkich zmian (zwiększany po liczniku części).
+    std::atomic_uint64_t total;
+    //! Części bloku kontrolnego.
+    part_block_t part[parts];
+};
+static void unmapBlock(void * b){
+    ::munmap(((char*)b)-block_offset,::sysconf(_SC_PAGESIZE));
+}
+control::~control(){
+    if (block.load()) unmapBlock(block.load());
+    for (block_t * b : retired) unmapBlock(b);
+    if (0<=fd) ::close(fd);
+}
+void control::map(){
+    static const std::size_t page=::sysconf(_SC_PAGESIZE);
+    struct stat st;
+    void * m;
+    if (fd<0) fd=::open(file_path.c_str(),O_RDWR|O_CREAT|O_CLOEXEC,S_IRUSR|S_IWUSR);
+    if ((fd<0)||::fstat(fd,&st)) return;
+    if (((std::size_t)st.st_size<page)&&::ftruncate(fd,page)) return;
+    m=::mmap(nullptr,page,PROT_READ|PROT_WRITE,MAP_SHARED,fd,0);
+    if (m==MAP_FAILED) return;
+    block.store((block_t*)(((char*)m)+block_offset),std::memory_order_release);
+}
+bool control::check(){
+    std::lock_guard<std::mutex> lock(mutex);
+    block_t * b=block.load(std::memory_order_relaxed);
+    if (b){
+        struct stat st;
+        if ((::fstat(fd,&st)==0)&&(st.st_nlink!=0)) return true;
+        // Plik został usunięty (np. razem z katalogiem kolejki) - licznik w nowym pliku nie jest ciągiem dalszym poprzedniego.
+        retired.push_back(b);
+        block.store(nullptr,std::memory_order_release);
+        ::close(fd);
+        fd=-1;
+    }
+    map();
+    return false;
+}
+bool control::generation(const part_t & part,std::uint64_t & value) const{
+    const block_t * b=block.load(std::memory_order_acquire);
+    if (!b) return false;
+    value=b->part[part].generation.load();
+    return true;
+}
+bool control::total(std::uint64_t & value) const{
+    const block_t * b=block.load(std::memory_order_acquire);
+    if (!b) return false;
+    value=b->total.load();
+    return true;
+}
+bool control::advance(const part_t & part,std::uint64_t & previous,std::uint64_t & previousTotal){
+    block_t * b=block.load(std::memory_order_acquire);
+    if (!b) return false;
+    // Licznik wszystkich zmian jest zwiększany jako drugi - kto odczytał jego nową wartość, odczyta też nowy licznik części.
+    previous=b->part[part].generation.fetch_add(1);
+    previousTotal=b->total.fetch_add(1);
+    return true;
+}
+void control::publish(const part_t & part,const std::uint64_t & value,const std::uint64_t & known){
+    block_t * b=block.load(std::memory_order_acquire);
+    if (!b) return;
+    b->part[part].value.store(value);
+    b->part[part].published.store(known+1);
+}
+bool control::published(const part_t & part,std::uint64_t & value) const{
+    const block_t * b=block.load(std::memory_order_acquire);
+    std::uint64_t p;
+    if (!b) return false;
+    p=b->part[part].published.load();
+    value=b->part[part].value.load();
+    // Wartość jest ważna, jeśli po publikacji nie było żadnej zmiany plików, których dotyczy część.
+    return (p!=0)&&(p==(b->part[part].generation.load()+1));
+}
+void control::withdraw(){
+    block_t * b=block.load(std::memory_order_acquire);
+    if (b) for (std::size_t k=0;k<parts;k++) b->part[k].published.store(0);
+}
+bool control::state(ict::queue::types::state_t & s) const{
+    const block_t * b=block.load(std::memory_order_acquire);
+    if (!b) return false;
+    auto valid=[b](const part_t & part,std::uint64_t & value){
+        std::uint64_t p=b->part[part].published.load();
+        value=b->part[part].value.load();
+        return (p!=0)&&(p==(b->part[part].generation.load()+1));
+    };
+    for (std::size_t k=0;k<state_attempts;k++){
+        std::uint64_t t=b->total.load();
+        std::uint64_t files;
+        // Numer do odczytu jest odczytywany przed numerem do zapisu (nie może go wtedy przekroczyć).
+        if (!valid(read_part,s.read_sequence)) return false;
+        if (!valid(write_part,s.write_sequence)) return false;
+        if (!valid(layout_part,files)) return false;
+        // Licznik wszystkich zmian nie zmienił się - części nie zmieniły się między odczytami.
+        if (b->total.load()!=t) continue;
+        s.files=files;
+        s.size=(s.read_sequence<s.write_sequence)?(s.write_sequence-s.read_sequence):0;
+        return true;
+    }
+    return false;
+}
+//===========================================
+} } }
+//===========================================
+#ifdef ENABLE_TESTING
+#include "test.hpp"
+#include <filesystem>
+#include <sys/wait.h>
+
+static ict::queue::types::path_t dirpath("/tmp/test-filecontrol");
+REGISTER_TEST(filecontrol,tc1){
+    int out=0;
+    std::filesystem::remove_all(dirpath);
+    std::filesystem::create_directory(dirpath);
+    {
+        ict::queue::file::control a(dirpath);
+        ict::queue::file::control b(dirpath);
+        std::uint64_t g0=0,g=0,t0=0,t=0;
+        const ict::queue::file::control::part_t w=ict::queue::file::control::write_part;
+        const ict::queue::file::control::part_t r=ict::queue::file::control::read_part;
+        const ict::queue::file::control::part_t l=ict::queue::file::control::layout_part;
+        // Pierwsze sprawdzenie nie jest aktualne (plik został dopiero odwzorowany).
+        if (a.check()||(!a.generation(w,g0))) out=1;
+        if ((out==0)&&((!a.total(t0))||(!a.advance(w,g,t))||(g!=g0)||(t!=t0))) out=2;
+        if ((out==0)&&(b.check()||(!b.generation(w,g))||(g!=(g0+1)))) out=3;
+        if ((out==0)&&((!a.check())||(!b.check()))) out=4;
+        if (out==0){
+            // Licznik jest wspólny dla wszystkich procesów używających katalogu.
+            pid_t pid=::fork();
+            if (pid==0){
+                ict::queue::file::control c(dirpath);
+                c.check();
+                ::_exit(c.advance(w,g,t)?0:1);
+            }
+            int status=-1;
+            ::waitpid(pid,&status,0);
+            if ((!WIFEXITED(status))||(WEXITSTATUS(status)!=0)) out=5;
+        }
+        if ((out==0)&&((!a.generation(w,g))||(g!=(g0+2)))) out=6;
+        // Licznik wszystkich zmian jest zwiększany razem z licznikiem części.
+        if ((out==0)&&((!b.total(t))||(t!=(t0+2)))) out=18;
+        // Liczniki części są niezależne.
+        if ((out==0)&&((!a.generation(r,g0))||(g0!=0)||(!a.generation(l,g0))||(g0!=0))) out=17;
+        if (out==0){
+            ict::queue::types::state_t s;
+            std::uint64_t v=0;
+            if (a.state(s)) out=10;
+            // Wartość opublikowana przy nieaktualnej wartości licznika nie jest ważna.
+            if (out==0) a.publish(w,5,g-1);
+            if ((out==0)&&b.published(w,v)) out=11;
+            if (out==0){
+                a.publish(w,5,g);
+                a.publish(r,3,0);
+                a.publish(l,1,0);
+            }
+            if ((out==0)&&((!b.state(s))||(s.size!=2)||(s.read_sequence!=3)||(s.write_sequence!=5)||(s.files!=1))) out=12;
+            if (out==0) b.publish(r,4,0);
+            if ((out==0)&&((!a.state(s))||(s.size!=1)||(s.read_sequence!=4))) out=13;
+            // Zmiana plików strony zapisu po publikacji (np. przerwany zapis) unieważnia tylko jej wartość.
+            if ((out==0)&&((!b.advance(w,g,t))||a.state(s)||a.published(w,v)||(!a.published(r,v))||(v!=4))) out=14;
+            if (out==0) a.publish(w,6,g+1);
+            if ((out==0)&&((!b.state(s))||(s.size!=2)||(s.write_sequence!=6))) out=15;
+            if (out==0) a.withdraw();
+            if ((out==0)&&(b.state(s)||b.published(r,v))) out=16;
+        }
+        if (out==0){
+            // Plik blokady utworzony od nowa - licznik nie jest aktualny.
+            std::filesystem::remove(dirpath+"/dir.lock");
+            if (a.check()||(!a.generation(w,g))||(g!=0)) out=7;
+            if ((out==0)&&(!a.advance(w,g,t))) out=8;
+            if ((out==0)&&(b.check()||(!b.generation(w,g))||(g!=1)||(!b.total(t))||(t!=1))) out=9;
+        }
+    }
+    std::filesystem::remove_all(dirpath);
+    return out;
+}
+#endif
+//===========================================
@@ -0,0 +1,165 @@
+//! @file
+//! @brief File control module - header file.
+//! @author Mariusz Ornowski (mariusz.ornowski@ict-project.pl)
+//! @date 2026
+//! @copyright ICT-Project Mariusz Ornowski (ict-project.pl)
+/* **************************************************************
+Copyright (c) 2026, ICT-Project Mariusz Ornowski (ict-project.pl)
+All rights reserved.
+
+Redistribution and use in source and binary forms, with or without
+modification, are permitted provided that the following conditions
+are met:
+
+1. Redistributions of source code must retain the above copyright
+notice, this list of conditions and the following disclaimer.
+2. Redistributions in binary form must reproduce the above copyright
+notice, this list of conditions and the following disclaimer in the
+documentation and/or other materials provided with the distribution.
+3. Neither the name of the ICT-Project Mariusz Ornowski nor the names
+of its contributors may be used to endorse or promote products
+derived from this software without specific prior written permission.
+
+THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+"AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR
+A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT
+HOLDER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,
+SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT
+LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,
+DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY
+THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+(INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+**************************************************************/
+#ifndef _FILE_CONTROL_HEADER
+#define _FILE_CONTROL_HEADER
+//============================================
+#include "types.hpp"
+#include <string>
+#include <cstdint>
+#include <atomic>
+#include <mutex>
+#include <vector>
+//============================================
+namespace ict { namespace  queue { namespace  file {
+//===========================================
+//! Blok kontrolny kolejki - liczniki zmian i opublikowany stan kolejki w pliku blokady katalogu odwzorowanym w pamięci (współdzielony przez wszystkie procesy).
+//! Blok ma osobne części dla puli plików, strony zapisu i strony odczytu - każdą część zmienia tylko właściciel jej strony, więc proces
+//! sprawdza tylko te części, które zmienił ktoś inny (zob. ict::queue::file::interface::sync()). Licznik części jest zwiększany przy każdej
+//! zmianie plików kolejki, której ta część dotyczy, a opublikowana wartość jest ważna tylko przy wartości licznika, przy której została opublikowana.
+//! Po liczniku części zwiększany jest licznik wszystkich zmian, więc jego jeden odczyt wystarcza, aby stwierdzić, że żadna część się nie zmieniła.
+class control {
+public:
+    //! Typ - Część bloku kontrolnego.
+    enum part_t {
+        //! Pula plików (zmieniana tylko przy zablokowanych obu stronach kolejki) - wartością jest liczba plików.
+        layout_part=0,
+        //! Strona zapisu - wartością jest numer kolejny następnego elementu do zapisu.
+        write_part,
+        //! Strona odczytu - wartością jest numer kolejny następnego elementu do odczytu.
+        read_part
+    };
+    //! Liczba części bloku kontrolnego.
+    static const std::size_t parts=3;
+private:
+    //! Typ - Blok kontrolny w pliku blokady.
+    struct block_t;
+    //! Nazwa pliku blokady.
+    static const std::string file_name;
+    //! Ścieżka do pliku blokady.
+    const std::string file_path;
+    //! Deskryptor pliku blokady.
+    int fd=-1;
+    //! Mutex dla odwzorowania pliku (strona zapisu i strona odczytu kolejki działają równocześnie).
+    std::mutex mutex;
+    //! Blok kontrolny (pusty, jeśli plik nie jest odwzorowany).
+    std::atomic<block_t*> block{nullptr};
+    //! Wcześniejsze odwzorowania pliku blokady (usuwane dopiero w destruktorze, bo mogą być jeszcze odczytywane).
+    std::vector<block_t*> retired;
+    //! 
+    //! @brief Otwiera i odwzorowuje plik blokady.
+    //! 
+    void map();
+public:
+    //! 
+    //! @brief Konstruktor.
+    //! 
+    //! @param dirname Ścieżka do katalogu z plikami kolejki.
+    //! 
+    control(const ict::queue::types::path_t & dirname):file_path(dirname+file_name){}
+    //! 
+    //! @brief Destruktor.
+    //! 
+    ~control();
+    //! 
+    //! @brief Sprawdza, czy odwzorowany plik blokady nadal istnieje (mógł zostać usunięty, np. razem z katalogiem kolejki), i odwzorowuje go od nowa, jeśli nie.
+    //! 
+    //! @return true Liczniki mogą być porównane z wcześniej odczytanymi.
+    //! @return false Plik został odwzorowany od nowa lub nie jest dostępny (pliki kolejki trzeba sprawdzić).
+    //! 
+    bool check();
+    //! 
+    //! @brief Odczytuje licznik zmian części bloku.
+    //! 
+    //! @param part Część bloku.
+    //! @param value Wartość licznika.
+    //! @return true Licznik został odczytany.
+    //! @return false Licznik nie jest dostępny.
+    //! 
+    bool generation(const part_t & part,std::uint64_t & value) const;
+    //! 
+    //! @brief Odczytuje licznik wszystkich zmian (zwiększany po liczniku części przy każdej zmianie).
+    //! 
+    //! @param value Wartość licznika.
+    //! @return true Licznik został odczytany.
+    //! @return false Licznik nie jest dostępny.
+    //! 
+    bool total(std::uint64_t & value) const;
+    //! 
+    //! @brief Zwiększa licznik zmian części bloku, a potem licznik wszystkich zmian.
+    //! 
+    //! @param part Część bloku.
+    //! @param previous Wartość licznika części przed zwiększeniem.
+    //! @param previousTotal Wartość licznika wszystkich zmian przed zwiększeniem.
+    //! @return true Liczniki zostały zwiększone.
+    //! @return false Liczniki nie są dostępne.
+    //! 
+    bool advance(const part_t & part,std::uint64_t & previous,std::uint64_t & previousTotal);
+    //! 
+    //! @brief Publikuje wartość części bloku (strona kolejki, do której należy część, musi być zablokowana).
+    //! 
+    //! @param part Część bloku.
+    //! @param value Wartość.
+    //! @param known Wartość licznika zmian części, przy której wartość jest aktualna.
+    //! 
+    void publish(const part_t & part,const std::uint64_t & value,const std::uint64_t & known);
+    //! 
+    //! @brief Odczytuje opublikowaną wartość części bloku.
+    //! 
+    //! @param part Część bloku.
+    //! @param value Wartość.
+    //! @return true Wartość została odczytana.
+    //! @return false Wartość nie została opublikowana albo licznik zmian części zmienił się po publikacji.
+    //! 
+    bool published(const part_t & part,std::uint64_t & value) const;
+    //! 
+    //! @brief Unieważnia opublikowany stan kolejki (wszystkie części).
+    //! 
+    void withdraw();
+    //! 
+    //! @brief Odczytuje opublikowany stan kolejki bez blokowania katalogu (tylko odczyty z pamięci, także bez mutexu). Części są
+    //!        odczytywane między dwoma odczytami licznika wszystkich zmian, więc pochodzą z tej samej chwili. Rozmiar kolejki
+    //!        jest różnicą numerów kolejnych, więc w trakcie operacji na kolejce może być nieaktualny o te operacje.
+    //! 
+    //! @param s Stan kolejki.
+    //! @return true Stan został odczytany.
+    //! @return false Któraś z części nie została opublikowana albo jej licznik zmian zmienił się po publikacji (np. zapis przez
+    //!         ict::queue::basic lub zapis przerwany przed publikacją) - stan trzeba odczytać pod blokadą.
+    //! 
+    bool state(ict::queue::types::state_t & s) const;
+};
+//===========================================
+} } }
+//============================================
+#endif
@@ -0,0 +1,193 @@
+//! @file
+//! @brief File cursor module - Source file.
+//! @author Mariusz Ornowski (mariusz.ornowski@ict-project.pl)
+//! @date 2026
+//! @copyright ICT-Project Mariusz Ornowski (ict-project.pl)
+/* **************************************************************
+Copyright (c) 2026, ICT-Project Mariusz Ornowski (ict-project.pl)
+All rights reserved.
+
+Redistribution and use in source and binary forms, with or without
+modification, are permitted provided that the following conditions
+are met:
+
+1. Redistributions of source code must retain the above copyright
+notice, this list of conditions and the following disclaimer.
+2. Redistributions in binary form must reproduce the above copyright
+notice, this list of conditions and the following disclaimer in the
+documentation and/or other materials provided with the distribution.
+3. Neither the name of the ICT-Project Mariusz Ornowski nor the names
+of its contributors may be used to endorse or promote products
+derived from this software without specific prior written permission.
+
+THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+"AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR
+A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT
+HOLDER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,
+SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT
+LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,
+DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY
+THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+(INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+**************************************************************/
+//============================================
+#include "file-cursor.hpp"
+#include <system_error>
+#include <cerrno>
+#include <unistd.h>
+#include <fcntl.h>
+#include <sys/stat.h>
+//============================================
+namespace ict { namespace  queue { namespace  file {
+//============================================
+const std::string cursor::file_name="/read.cursor";
+std::uint64_t cursor::checksum(const slot_t & slot){
+    // FNV-1a
+    const std::uint64_t data[4]={slot.sequence,slot.position.file,slot.position.offset,slot.position.count};
+    const unsigned char * p=(const unsigned char *)data;
+    std::uint64_t output=0xcbf29ce484222325ULL;
+    for (std::size_t k=0;k<sizeof(data);k++){
+        output^=p[k];
+        output*=0x100000001b3ULL;
+    }
+    return output;
+}
+bool cursor::open(bool create){
+    if (fd<0){
+        fd=::open(file_path.c_str(),create?(O_RDWR|O_CREAT|O_CLOEXEC):(O_RDWR|O_CLOEXEC),0644);
+        if (fd<0){
+            if ((!create)&&(errno==ENOENT)) return false;
+            throw std::system_error(errno,std::generic_category(),"ict::queue::file::cursor open failed!");
+        }
+    }
+    return true;
+}
+cursor::~cursor(){
+    if (0<=fd) ::close(fd);
+}
+bool cursor::load(){
+    slot_t slots[2];
+    ssize_t s;
+    bool found=false;
+    if (0<=fd){
+        struct stat st;
+        // Plik został usunięty (np. razem z katalogiem kolejki) - trzeba go otworzyć ponownie.
+        if ((::fstat(fd,&st)==0)&&(st.st_nlink==0)){
+            ::close(fd);
+            fd=-1;
+        }
+    }
+    if (!open(false)) {
+        sequence=0;
+        current=position_t();
+        return false;
+    }
+    s=::pread(fd,slots,sizeof(slots),0);
+    if (s<0) throw std::system_error(errno,std::generic_category(),"ict::queue::file::cursor read failed!");
+    for (std::size_t k=0;(k+1)*sizeof(slot_t)<=(std::size_t)s;k++){
+        if (slots[k].sequence&&(slots[k].checksum==checksum(slots[k]))){
+            if ((!found)||(sequence<slots[k].sequence)){
+                sequence=slots[k].sequence;
+                current=slots[k].position;
+                found=true;
+            }
+        }
+    }
+    if (!found) {
+        sequence=0;
+        current=position_t();
+    }
+    return found;
+}
+bool cursor::changed(){
+    std::uint64_t previous=sequence;
+    load();
+    return previous!=sequence;
+}
+void cursor::store(const position_t & position){
+    slot_t slot;
+    open(true);
+    slot.sequence=sequence+1;
+    slot.position=position;
+    slot.checksum=checksum(slot);
+    // Zapis do slotu, który nie zawiera ostatniego zapisu - przerwany zapis nie niszczy poprzedniej pozycji.
+    if (::pwrite(fd,&slot,sizeof(slot_t),(slot.sequence%2)*sizeof(slot_t))!=(ssize_t)sizeof(slot_t)) 
+        throw std::system_error(errno,std::generic_category(),"ict::queue::file::cursor write failed!");
+    sequence=slot.sequence;
+    current=position;
+}
+void cursor::sync(){
+    if (0<=fd) ::fdatasync(fd);
+}
+bool cursor::valid() const{
+    return sequence!=0;
+}
+const cursor::position_t & cursor::get() const{
+    return current;
+}
+//===========================================
+} } }
+//===========================================
+#ifdef ENABLE_TESTING
+#include "test.hpp"
+#include <filesystem>
+#include <fstream>
+
+static ict::queue::types::path_t dirpath("/tmp/test-filecursor");
+REGISTER_TEST(filecursor,tc1){
+    int out=0;
+    std::filesystem::remove_all(dirpath);
+    std::filesystem::create_directory(dirpath);
+    {
+        ict::queue::file::cursor c(dirpath);
+        if (c.load()||c.valid()) out=1;
+        for (std::uint64_t k=1;(out==0)&&(k<=5);k++){
+            ict::queue::file::cursor::position_t p;
+            p.file=k;
+            p.offset=100*k;
+            p.count=k;
+            c.store(p);
+        }
+    }
+    if (out==0) {
+        ict::queue::file::cursor c(dirpath);
+        if (!c.load()){
+            out=2;
+        } else if ((c.get().file!=5)||(c.get().offset!=500)||(c.get().count!=5)){
+            std::cerr<<"file="<<c.get().file<<" offset="<<c.get().offset<<" count="<<c.get().count<<std::endl;
+            out=3;
+        }
+    }
+    if (out==0) {
+        // Uszkodzenie ostatniego zapisu (slot 1) - powinna zostać odczytana poprzednia pozycja.
+        std::fstream f(dirpath+"/read.cursor",std::ios::in|std::ios::out|std::ios::binary);
+        f.seekp(40+8);
+        f.put('x');
+    }
+    if (out==0) {
+        ict::queue::file::cursor c(dirpath);
+        if (!c.load()){
+            out=4;
+        } else if ((c.get().file!=4)||(c.get().offset!=400)||(c.get().count!=4)){
+            std::cerr<<"file="<<c.get().file<<" offset="<<c.get().offset<<" count="<<c.get().count<<std::endl;
+            out=5;
+        }
+    }
+    if (out==0) {
+        ict::queue::file::cursor c1(dirpath);
+        ict::queue::file::cursor c2(dirpath);
+        ict::queue::file::cursor::position_t p;
+        c1.load();
+        c2.load();
+        if (c1.changed()) out=6;
+        p.count=10;
+        if (out==0) c2.store(p);
+        if ((out==0)&&((!c1.changed())||(c1.get().count!=10))) out=7;
+    }
+    std::filesystem::remove_all(dirpath);
+    return out;
+}
+#endif
+//===========================================
@@ -0,0 +1,143 @@
+//! @file
+//! @brief File cursor module - header file.
+//! @author Mariusz Ornowski (mariusz.ornowski@ict-project.pl)
+//! @date 2026
+//! @copyright ICT-Project Mariusz Ornowski (ict-project.pl)
+/* **************************************************************
+Copyright (c) 2026, ICT-Project Mariusz Ornowski (ict-project.pl)
+All rights reserved.
+
+Redistribution and use in source and binary forms, with or without
+modification, are permitted provided that the following conditions
+are met:
+
+1. Redistributions of source code must retain the above copyright
+notice, this list of conditions and the following disclaimer.
+2. Redistributions in binary form must reproduce the above copyright
+notice, this list of conditions and the following disclaimer in the
+documentation and/or other materials provided with the distribution.
+3. Neither the name of the ICT-Project Mariusz Ornowski nor the names
+of its contributors may be used to endorse or promote products
+derived from this software without specific prior written permission.
+
+THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+"AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR
+A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT
+HOLDER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,
+SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT
+LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,
+DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY
+THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+(INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+**************************************************************/
+#ifndef _FILE_CURSOR_HEADER
+#define _FILE_CURSOR_HEADER
+//============================================
+#include "types.hpp"
+#include <string>
+#include <cstdint>
+//============================================
+namespace ict { namespace  queue { namespace  file {
+//===========================================
+//! Plik kursora odczytu - pozycja odczytu kolejki zapisywana poza plikami z danymi (dwa sloty z sumą kontrolną, zapisywane na zmianę).
+class cursor {
+public:
+    //! Typ - Pozycja odczytu.
+    struct position_t {
+        //! Numer pliku z danymi, którego dotyczy pozycja.
+        std::uint64_t file=0;
+        //! Pozycja odczytu w pliku z danymi.
+        std::uint64_t offset=0;
+        //! Liczba wszystkich elementów odczytanych z kolejki.
+        std::uint64_t count=0;
+    };
+private:
+    //! Typ - Slot zapisany w pliku kursora.
+    struct slot_t {
+        //! Numer kolejny zapisu (0 - slot pusty).
+        std::uint64_t sequence;
+        //! Pozycja odczytu.
+        position_t position;
+        //! Suma kontrolna.
+        std::uint64_t checksum;
+    };
+    //! Nazwa pliku kursora.
+    static const std::string file_name;
+    //! Ścieżka do pliku kursora.
+    const std::string file_path;
+    //! Deskryptor pliku kursora.
+    int fd=-1;
+    //! Numer kolejny ostatnio odczytanego lub zapisanego slotu.
+    std::uint64_t sequence=0;
+    //! Ostatnio odczytana lub zapisana pozycja odczytu.
+    position_t current;
+    //! 
+    //! @brief Wylicza sumę kontrolną slotu.
+    //! 
+    //! @param slot Slot.
+    //! @return Suma kontrolna.
+    //! 
+    static std::uint64_t checksum(const slot_t & slot);
+    //! 
+    //! @brief Otwiera plik kursora.
+    //! 
+    //! @param create Czy utworzyć plik, jeśli nie istnieje.
+    //! @return true Plik jest otwarty.
+    //! @return false Plik nie istnieje.
+    //! 
+    bool open(bool create);
+public:
+    //! 
+    //! @brief Konstruktor.
+    //! 
+    //! @param dirname Ścieżka do katalogu z plikami kolejki.
+    //! 
+    cursor(const ict::queue::types::path_t & dirname):file_path(dirname+file_name){}
+    //! 
+    //! @brief Destruktor.
+    //! 
+    ~cursor();
+    //! 
+    //! @brief Odczytuje pozycję odczytu z pliku (wybiera poprawny slot z najnowszym zapisem).
+    //! 
+    //! @return true Pozycja została odczytana.
+    //! @return false Plik nie istnieje lub nie zawiera poprawnego slotu.
+    //! 
+    bool load();
+    //! 
+    //! @brief Sprawdza, czy pozycja odczytu w pliku została zmieniona (np. przez inny proces) i odczytuje ją, jeśli tak.
+    //! 
+    //! @return true Pozycja została zmieniona.
+    //! @return false Pozycja nie została zmieniona.
+    //! 
+    bool changed();
+    //! 
+    //! @brief Zapisuje pozycję odczytu w pliku (w slocie, który nie zawiera ostatniego zapisu).
+    //! 
+    //! @param position Pozycja odczytu.
+    //! 
+    void store(const position_t & position);
+    //! 
+    //! @brief Synchronizuje plik kursora z dyskiem (fdatasync).
+    //! 
+    void sync();
+    //! 
+    //! @brief Sprawdza, czy pozycja odczytu jest znana (plik kursora istnieje i zawiera poprawny slot).
+    //! 
+    //! @return true Pozycja jest znana.
+    //! @return false Pozycja nie jest znana.
+    //! 
+    bool valid() const;
+    //! 
+    //! @brief Zwraca ostatnio odczytaną lub zapisaną pozycję odczytu.
+    //! 
+    //! @return Pozycja odczytu.
+    //! 
+    const position_t & get() const;
+};
+//===========================================
+} } }
+//============================================
+#endif
@@ -0,0 +1,143 @@
+//! @file
+//! @brief File index module - Source file.
+//! @author Mariusz Ornowski (mariusz.ornowski@ict-project.pl)
+//! @date 2026
+//! @copyright ICT-Project Mariusz Ornowski (ict-project.pl)
+/* **************************************************************
+Copyright (c) 2026, ICT-Project Mariusz Ornowski (ict-project.pl)
+All rights reserved.
+
+Redistribution and use in source and binary forms, with or without
+modification, are permitted provided that the following conditions
+are met:
+
+1. Redistributions of source code must retain the above copyright
+notice, this list of conditions and the following disclaimer.
+2. Redistributions in binary form must reproduce the above copyright
+notice, this list of conditions and the following disclaimer in the
+documentation and/or other materials provided with the distribution.
+3. Neither the name of the ICT-Project Mariusz Ornowski nor the names
+of its contributors may be used to endorse or promote products
+derived from this software without specific prior written permission.
+
+THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+"AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR
+A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT
+HOLDER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,
+SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT
+LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,
+DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY
+THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+(INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+**************************************************************/
+//============================================
+#include "file-index.hpp"
+#include <vector>
+#include <algorithm>
+#include <filesystem>
+#include <unistd.h>
+#include <fcntl.h>
+#include <sys/stat.h>
+//============================================
+namespace ict { namespace  queue { namespace  file {
+//============================================
+ict::queue::types::path_t index::getPath(const ict::queue::types::path_t & path){
+    return std::filesystem::path(path).replace_extension(".idx").string();
+}
+bool index::append(const entry_t & entry){
+    bool out;
+    int fd=::open(file_path.c_str(),O_WRONLY|O_CREAT|O_APPEND|O_CLOEXEC,0644);
+    if (fd<0) return false;
+    out=(::write(fd,&entry,sizeof(entry_t))==(ssize_t)sizeof(entry_t));
+    ::close(fd);
+    return out;
+}
+bool index::last(entry_t & entry) const{
+    struct stat st;
+    bool out=false;
+    int fd=::open(file_path.c_str(),O_RDONLY|O_CLOEXEC);
+    if (fd<0) return false;
+    // Niepełny wpis na końcu pliku (przerwany zapis) jest pomijany.
+    if ((::fstat(fd,&st)==0)&&(sizeof(entry_t)<=(std::size_t)st.st_size)){
+        const off_t position=(st.st_size/sizeof(entry_t)-1)*sizeof(entry_t);
+        out=(::pread(fd,&entry,sizeof(entry_t),position)==(ssize_t)sizeof(entry_t));
+    }
+    ::close(fd);
+    return out;
+}
+bool index::find(const std::uint64_t & sequence,entry_t & entry) const{
+    struct stat st;
+    std::vector<entry_t> entries;
+    int fd=::open(file_path.c_str(),O_RDONLY|O_CLOEXEC);
+    if (fd<0) return false;
+    if (::fstat(fd,&st)==0){
+        entries.resize(st.st_size/sizeof(entry_t));
+        ssize_t s=::pread(fd,entries.data(),entries.size()*sizeof(entry_t),0);
+        entries.resize((s<0)?0:(s/sizeof(entry_t)));
+    }
+    ::close(fd);
+    std::vector<entry_t>::const_iterator it=std::upper_bound(entries.cbegin(),entries.cend(),sequence,[](const std::uint64_t & s,const entry_t & e){
+        return s<e.sequence;
+    });
+    if (it==entries.cbegin()) return false;
+    entry=*(--it);
+    return true;
+}
+//===========================================
+} } }
+//===========================================
+#ifdef ENABLE_TESTING
+#include "test.hpp"
+#include <fstream>
+
+static ict::queue::types::path_t dirpath("/tmp/test-fileindex");
+REGISTER_TEST(fileindex,tc1){
+    int out=0;
+    const ict::queue::types::path_t path(dirpath+"/0000000000000001.dat");
+    std::filesystem::remove_all(dirpath);
+    std::filesystem::create_directory(dirpath);
+    if (ict::queue::file::index::getPath(path)!=dirpath+"/0000000000000001.idx") out=1;
+    if (out==0) {
+        ict::queue::file::index i(path);
+        ict::queue::file::index::entry_t e;
+        if (i.last(e)||i.find(10,e)) out=2;
+        for (std::uint64_t k=1;(out==0)&&(k<=5);k++){
+            if (!i.append({10*k,1000*k})) out=3;
+        }
+    }
+    if (out==0) {
+        ict::queue::file::index i(path);
+        ict::queue::file::index::entry_t e;
+        if (i.find(9,e)) {
+            out=4;
+        } else if ((!i.find(10,e))||(e.sequence!=10)||(e.offset!=1000)) {
+            out=5;
+        } else if ((!i.find(37,e))||(e.sequence!=30)||(e.offset!=3000)) {
+            out=6;
+        } else if ((!i.find(1000,e))||(e.sequence!=50)) {
+            out=7;
+        } else if ((!i.last(e))||(e.sequence!=50)||(e.offset!=5000)) {
+            out=8;
+        }
+    }
+    if (out==0) {
+        // Niepełny wpis (przerwany zapis) jest pomijany.
+        std::ofstream f(ict::queue::file::index::getPath(path),std::ios::out|std::ios::app|std::ios::binary);
+        f.write("xyz",3);
+    }
+    if (out==0) {
+        ict::queue::file::index i(path);
+        ict::queue::file::index::entry_t e;
+        if ((!i.last(e))||(e.sequence!=50)) {
+            out=9;
+        } else if ((!i.find(1000,e))||(e.sequence!=50)) {
+            out=10;
+        }
+    }
+    std::filesystem::remove_all(dirpath);
+    return out;
+}
+#endif
+//===========================================
@@ -0,0 +1,101 @@
+//! @file
+//! @brief File index module - header file.
+//! @author Mariusz Ornowski (mariusz.ornowski@ict-project.pl)
+//! @date 2026
+//! @copyright ICT-Project Mariusz Ornowski (ict-project.pl)
+/* **************************************************************
+Copyright (c) 2026, ICT-Project Mariusz Ornowski (ict-project.pl)
+All rights reserved.
+
+Redistribution and use in source and binary forms, with or without
+modification, are permitted provided that the following conditions
+are met:
+
+1. Redistributions of source code must retain the above copyright
+notice, this list of conditions and the following disclaimer.
+2. Redistributions in binary form must reproduce the above copyright
+notice, this list of conditions and the following disclaimer in the
+documentation and/or other materials provided with the distribution.
+3. Neither the name of the ICT-Project Mariusz Ornowski nor the names
+of its contributors may be used to endorse or promote products
+derived from this software without specific prior written permission.
+
+THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+"AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR
+A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT
+HOLDER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,
+SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT
+LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,
+DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY
+THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+(INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+**************************************************************/
+#ifndef _FILE_INDEX_HEADER
+#define _FILE_INDEX_HEADER
+//============================================
+#include "types.hpp"
+#include <string>
+#include <cstdint>
+//============================================
+namespace ict { namespace  queue { namespace  file {
+//===========================================
+//! Rzadki indeks pliku z danymi - numery kolejne wybranych elementów i ich pozycje w pliku (plik obok pliku z danymi, z rozszerzeniem .idx).
+//! Indeks służy tylko przyspieszeniu wyszukiwania elementu (zob. interface::seek()), więc błędy zapisu nie są zgłaszane.
+class index {
+public:
+    //! Typ - Wpis w indeksie.
+    struct entry_t {
+        //! Numer kolejny elementu.
+        std::uint64_t sequence=0;
+        //! Pozycja rekordu elementu w pliku z danymi.
+        std::uint64_t offset=0;
+    };
+private:
+    //! Ścieżka do pliku indeksu.
+    const std::string file_path;
+public:
+    //! 
+    //! @brief Konstruktor.
+    //! 
+    //! @param path Ścieżka do pliku z danymi.
+    //! 
+    index(const ict::queue::types::path_t & path):file_path(getPath(path)){}
+    //! 
+    //! @brief Zwraca ścieżkę do pliku indeksu dla podanego pliku z danymi.
+    //! 
+    //! @param path Ścieżka do pliku z danymi.
+    //! @return Ścieżka do pliku indeksu.
+    //! 
+    static ict::queue::types::path_t getPath(const ict::queue::types::path_t & path);
+    //! 
+    //! @brief Dodaje wpis na końcu indeksu.
+    //! 
+    //! @param entry Wpis do dodania.
+    //! @return true Wpis został dodany.
+    //! @return false Wpis nie został dodany.
+    //! 
+    bool append(const entry_t & entry);
+    //! 
+    //! @brief Odczytuje ostatni wpis z indeksu.
+    //! 
+    //! @param entry Odczytany wpis.
+    //! @return true Wpis został odczytany.
+    //! @return false Indeks nie istnieje lub jest pusty.
+    //! 
+    bool last(entry_t & entry) const;
+    //! 
+    //! @brief Wyszukuje wpis z największym numerem kolejnym, który nie jest większy od podanego.
+    //! 
+    //! @param sequence Szukany numer kolejny.
+    //! @param entry Znaleziony wpis.
+    //! @return true Wpis został znaleziony.
+    //! @return false Indeks nie istnieje lub nie zawiera takiego wpisu.
+    //! 
+    bool find(const std::uint64_t & sequence,entry_t & entry) const;
+};
+//===========================================
+} } }
+//============================================
+#endif
@@ -34,27 +34,47 @@ OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
 **************************************************************/
 //============================================
 #include "file-interface.hpp"
+#include "file-checksum.hpp"
+#include "file-record.hpp"
 #include <filesystem>
+#include <system_error>
+#include <cerrno>
+#include <unistd.h>
+#include <sys/stat.h>
 //============================================
 namespace ict { namespace  queue { namespace  file {
 //============================================
 std::size_t interface::getPositionFromFile(){
     std::size_t output=0;
     if (!fpool.empty()){
+        if (rcursor.valid()){
+            // Pozycja z pliku kursora dotyczy pliku o podanym numerze - jeśli to nie jest najstarszy plik, to odczyt zaczyna się od początku.
+            if (rcursor.get().file==fpool.getNumber(fpool.size()-1)) output=rcursor.get().offset;
+            return output;
+        }
+        // Kolejka bez pliku kursora (z wcześniejszej wersji) - pozycja odczytu jest w rekordach pliku do zapisu.
         std::ifstream s;
         ict::queue::types::record_t r;
+        ict::queue::types::format_t format;
         s.open(fpool.getPath(0),std::ios::in|std::ios::binary);
+        format=detectFormat(s,options.format);
+        s.seekg(formatBegin(format),std::ios::beg);
         while(s){
-            s>>r;
-            if (s) switch(r.type){
+            if (readRecord(s,format,r)) switch(r.type){
                 case ict::queue::types::payload_size_record:
+                case ict::queue::types::payload_checksum_record:
+                case ict::queue::types::padding_record:
                     s.seekg(r.data,std::ios::cur);
                     break;
                 case ict::queue::types::read_pointer_record:
                 case ict::queue::types::read_confirm_record:
                     output=r.data;
                     break;
+                case ict::queue::types::end_of_data_record:
+                    s.setstate(std::ios::failbit);
+                    break;
                 case ict::queue::types::queue_size_record:
+                case ict::queue::types::read_count_record:
                 default:break;
             };
         }
@@ -65,15 +85,59 @@ std::size_t interface::getSizeFromFile(){
     std::size_t output=0;
     if (!fpool.empty()){
         bool found=false;
+        bool end=false;
+        bool suspected=false;
+        std::uint64_t suspect=0;
+        std::size_t skipped=0;
+        std::uint64_t count=0;
+        std::uint64_t position=0;
         std::ifstream s;
         ict::queue::types::record_t r;
+        ict::queue::types::format_t format;
+        struct stat st;
+        checkpoint::state_t cp;
+        torn.found=false;
+        if (::stat(fpool.getPath(0).c_str(),&st)!=0) return output;
         s.open(fpool.getPath(0),std::ios::in|std::ios::binary);
-        while(s){
-            s>>r;
-            if (s) switch(r.type){
+        format=detectFormat(s,options.format);
+        // Stan z punktu kontrolnego - odczytywane są tylko rekordy zapisane później.
+        if (wcheckpoint.load(cp)&&(cp.file==fpool.getNumber(0))&&(cp.inode==(std::uint64_t)st.st_ino)&&(cp.offset<=(std::uint64_t)st.st_size)){
+            found=true;
+            output=cp.size;
+            count=cp.count;
+            position=cp.offset;
+        } else {
+            cp.offset=0;
+            position=std::min<std::uint64_t>(formatBegin(format),st.st_size);
+        }
+        s.seekg(position,std::ios::beg);
+        while(s&&(!end)){
+            std::uint64_t next;
+            const std::size_t n=readRecord(s,format,r);
+            if (!n) break;
+            next=position+n;
+            if ((r.type==ict::queue::types::payload_size_record)||(r.type==ict::queue::types::payload_checksum_record)||(r.type==ict::queue::types::padding_record)) next+=r.data;
+            // Niepełny rekord (zapis w trakcie lub przerwany) nie jest uwzględniany.
+            if ((std::uint64_t)st.st_size<next) break;
+            switch(r.type){
                 case ict::queue::types::payload_size_record:
                     s.seekg(r.data,std::ios::cur);
-                    if (found) output++;
+                    if (suspected) skipped++; else if (found) output++;
+                    break;
+                case ict::queue::types::payload_checksum_record:
+                    if (verifyRecord(s,r)){
+                        // Poprawny rekord za uszkodzonym - uszkodzenie nie jest skutkiem przerwanego zapisu (element zgłosi błąd przy odczycie).
+                        if (found) output+=skipped+1;
+                        suspected=false;
+                        skipped=0;
+                    } else {
+                        if (!suspected) suspect=position;
+                        suspected=true;
+                        skipped++;
+                    }
+                    break;
+                case ict::queue::types::padding_record:
+                    s.seekg(r.data,std::ios::cur);
                     break;
                 case ict::queue::types::read_pointer_record:
                     break;
@@ -84,55 +148,373 @@ std::size_t interface::getSizeFromFile(){
                     found=true;
                     output=r.data;
                     break;
-                default:break;
+                case ict::queue::types::read_count_record:
+                    count=r.data;
+                    break;
+                case ict::queue::types::end_of_data_record:
+                    // Kolejny zapis zastąpi ten rekord, więc punkt kontrolny wskazuje na jego początek.
+                    end=true;
+                    continue;
+                default:
+                    if (!suspected) suspect=position;
+                    suspected=true;
+                    break;
             };
+            position=next;
+        }
+        // Uszkodzone rekordy, za którymi nie ma poprawnego rekordu, i niepełny rekord na końcu pliku to przerwany zapis -
+        // odczyt kończy się na pierwszym z nich, a plik jest obcinany przed kolejnym zapisem (zob. getWriteStream()).
+        if (suspected) position=suspect;
+        if ((suspected||(!end))&&(position<(std::uint64_t)st.st_size)){
+            torn.found=true;
+            torn.file=fpool.getNumber(0);
+            torn.inode=st.st_ino;
+            torn.offset=position;
+        }
+        if (found&&(cp.offset!=position)){
+            cp.file=fpool.getNumber(0);
+            cp.inode=st.st_ino;
+            cp.offset=position;
+            cp.size=output;
+            cp.count=count;
+            wcheckpoint.store(cp);
+        }
+        // Elementy odczytane od zapisu rozmiaru kolejki (według licznika z pliku kursora).
+        if (found&&rcursor.valid()&&(count<=rcursor.get().count)){
+            std::size_t n=rcursor.get().count-count;
+            output=(n<output)?(output-n):0;
+        } else if (found&&rcursor.valid()) {
+            // Pozycja odczytu została cofnięta (zob. seek()) - elementy odczytane wcześniej są ponownie w kolejce.
+            output+=count-rcursor.get().count;
         }
     }
     return output;
 }
-interface::interface(const ict::queue::types::path_t & dirname,const std::size_t & maxFileSize,const std::size_t & maxFiles):
-    fpool(dirname,maxFileSize,maxFiles){
+bool interface::getSequenceFromFile(const std::size_t & i,std::uint64_t & sequence) const{
+    ict::queue::types::record_t r[2];
+    ict::queue::types::format_t format;
+    std::ifstream s;
+    s.open(fpool.getPath(i),std::ios::in|std::ios::binary);
+    format=detectFormat(s,options.format);
+    s.seekg(formatBegin(format),std::ios::beg);
+    // Pierwszy element w pliku ma numer równy liczbie elementów zapisanych wcześniej, czyli sumie rozmiaru kolejki i licznika odczytów.
+    if ((!readRecord(s,format,r[0]))||(r[0].type!=ict::queue::types::queue_size_record)) return false;
+    sequence=r[0].data;
+    if (readRecord(s,format,r[1])&&(r[1].type==ict::queue::types::read_count_record)) sequence+=r[1].data;
+    return true;
+}
+std::size_t interface::getOffsetFromFile(const std::size_t & i,const std::uint64_t & first,const std::uint64_t & sequence) const{
+    std::uint64_t current=first;
+    std::uint64_t position;
+    std::ifstream s;
+    ict::queue::types::record_t r;
+    ict::queue::types::format_t format;
+    index::entry_t e;
+    struct stat st;
+    if (::stat(fpool.getPath(i).c_str(),&st)!=0) throw std::domain_error("ict::queue::file::interface file doesn't exist!");
+    s.open(fpool.getPath(i),std::ios::in|std::ios::binary);
+    format=detectFormat(s,options.format);
+    position=formatBegin(format);
+    // Wpis w indeksie jest sprawdzany (indeks nie jest synchronizowany z dyskiem razem z plikiem z danymi).
+    if (index(fpool.getPath(i)).find(sequence,e)&&(first<=e.sequence)&&(position<=e.offset)&&(e.offset<(std::uint64_t)st.st_size)){
+        s.seekg(e.offset,std::ios::beg);
+        if (readRecord(s,format,r)&&((r.type==ict::queue::types::payload_size_record)||(r.type==ict::queue::types::payload_checksum_record))){
+            current=e.sequence;
+            position=e.offset;
+        }
+        s.clear();
+    }
+    s.seekg(position,std::ios::beg);
+    while(s){
+        std::uint64_t next;
+        const std::size_t n=readRecord(s,format,r);
+        if (!n) break;
+        const bool payload=(r.type==ict::queue::types::payload_size_record)||(r.type==ict::queue::types::payload_checksum_record);
+        next=position+n;
+        if (payload||(r.type==ict::queue::types::padding_record)) next+=r.data;
+        if (((std::uint64_t)st.st_size<next)||(r.type==ict::queue::types::end_of_data_record)) break;
+        if (payload){
+            if (current==sequence) return position;
+            current++;
+        }
+        if (payload||(r.type==ict::queue::types::padding_record)) s.seekg(r.data,std::ios::cur);
+        position=next;
+    }
+    if (current!=sequence) throw std::domain_error("ict::queue::file::interface element not found!");
+    return position;
+}
+interface::interface(const ict::queue::types::path_t & dirname,const std::size_t & maxFileSize,const std::size_t & maxFiles,const ict::queue::types::options_t & opt):
+    fpool(dirname,maxFileSize,maxFiles),max_file_size(maxFileSize),rcursor(dirname),wcheckpoint(dirname),qcontrol(dirname),confirmed(std::chrono::steady_clock::now()),options(opt),synced(std::chrono::steady_clock::now()),ahead(opt.read_ahead){
     refresh();
 }
+interface::~interface(){
+    confirmReadStream();
+    closeWriteStream();
+    if (cursorUnsynced.exchange(false)) rcursor.sync();
+}
+void interface::closeWriteStream(){
+    if (ostream){
+        switch(options.durability){
+            case ict::queue::types::fdatasync_durability:
+            case ict::queue::types::periodic_durability:
+                if (unflushed||unsynced) syncWriteStream();
+                break;
+            default:break;
+        }
+        ostream.reset(nullptr);
+        // Dane, które były tylko w buforze strumienia, zostały zapisane przy jego zamknięciu.
+        if (unflushed){
+            advance(control::write_part);
+            publishWrite();
+        }
+    }
+    unflushed=0;
+    unsynced=0;
+}
+void interface::syncDir(){
+    switch(options.durability){
+        case ict::queue::types::fdatasync_durability:
+        case ict::queue::types::periodic_durability:
+            fpool.sync();
+            break;
+        default:break;
+    }
+}
 void interface::writeInfo(){
-    {
-        ict::queue::types::record_t r_size={ict::queue::types::queue_size_record,0};
-        r_size.data=queue_size;
-        getWriteStream()<<r_size;
+    ict::queue::types::record_t r[2]={
+        {ict::queue::types::queue_size_record,0},
+        {ict::queue::types::read_count_record,0}
+    };
+    char buffer[2*max_record_size];
+    ict::queue::types::const_buffer_t b={buffer,0};
+    writer & w=getWriteStream();
+    r[1].data=rcursor.get().count;
+    r[0].data=write_sequence-r[1].data;
+    b.size=encodeRecord(r[0],wformat,buffer);
+    b.size+=encodeRecord(r[1],wformat,buffer+b.size);
+    w.write(&b,1);
+    unflushed+=b.size;
+    if (options.durability==ict::queue::types::fdatasync_durability){
+        syncWriteStream();
+    } else {
+        flushWriteStream();
     }
     {
-        ict::queue::types::record_t r_pointer={ict::queue::types::read_pointer_record,0};
-        if (istream) r_pointer.data=(*istream).tellg();
-        getWriteStream()<<r_pointer;
+        // Nowy plik - stan jest znany bez odczytu pliku.
+        struct stat st;
+        checkpoint::state_t cp;
+        if (::stat(fpool.getPath(0).c_str(),&st)==0){
+            cp.file=fpool.getNumber(0);
+            cp.inode=st.st_ino;
+            cp.offset=w.tellp();
+            cp.size=r[0].data;
+            cp.count=r[1].data;
+            wcheckpoint.store(cp);
+        }
     }
-    getWriteStream().flush();
 }
-std::ofstream & interface::getWriteStream(){
+bool interface::verifyRecord(std::istream & s,const ict::queue::types::record_t & r){
+    std::uint64_t size=r.data;
+    std::uint32_t crc=crc32c(0,&size,sizeof(size));
+    char buffer[1<<16];
+    while (size&&s){
+        const std::size_t n=(size<sizeof(buffer))?size:sizeof(buffer);
+        s.read(buffer,n);
+        crc=crc32c(crc,buffer,s.gcount());
+        size-=s.gcount();
+    }
+    return s&&(crc==r.checksum);
+}
+void interface::truncateWriteStream(){
+    struct stat st;
+    if (!torn.found) return;
+    torn.found=false;
+    if (torn.file!=fpool.getNumber(0)) return;
+    if ((::stat(fpool.getPath(0).c_str(),&st)!=0)||((std::uint64_t)st.st_ino!=torn.inode)||((std::uint64_t)st.st_size<=torn.offset)) return;
+    advance(control::write_part);
+    if (::truncate(fpool.getPath(0).c_str(),torn.offset)!=0) throw std::system_error(errno,std::generic_category(),"ict::queue::file::interface truncate failed!");
+}
+writer & interface::getWriteStream(){
     if (!ostream){
         if (fpool.empty()) throw std::underflow_error("ict::queue::file::interface is empty!");
-        ostream.reset(new std::ofstream);
-        ostream->open(fpool.getPath(0),std::ios::out|std::ios::binary|std::ios::app);
+        truncateWriteStream();
+        // Plik jest uzupełniany w swoim formacie (nowy, pusty plik - w formacie z opcji kolejki).
+        wformat=detectFormat(fpool.getPath(0),options.format);
+        ostream=writer::create(fpool.getPath(0),max_file_size,wformat,options);
     }
     return *ostream;
 }
+void interface::beginWriteStream(){
+    advance(control::write_part);
+}
+void interface::commitWriteStream(const std::size_t & bytes){
+    unflushed+=bytes;
+    switch(options.durability){
+        case ict::queue::types::buffered_durability:
+            break;
+        case ict::queue::types::fdatasync_durability:
+            syncWriteStream();
+            break;
+        case ict::queue::types::periodic_durability:
+            flushWriteStream();
+            if (options.sync_interval_bytes&&(options.sync_interval_bytes<=unsynced)) {
+                syncWriteStream();
+            } else if (options.sync_interval_ms&&(std::chrono::milliseconds(options.sync_interval_ms)<=(std::chrono::steady_clock::now()-synced))) {
+                syncWriteStream();
+            }
+            break;
+        case ict::queue::types::flush_durability:
+        default:
+            flushWriteStream();
+            break;
+    }
+}
+void interface::flushWriteStream(){
+    if (ostream&&unflushed){
+        ostream->flush();
+        unsynced+=unflushed;
+        unflushed=0;
+        advance(control::write_part);
+        publishWrite();
+    }
+}
+void interface::flush(){
+    confirmReadStream();
+    flushWriteStream();
+}
+void interface::storeReadPosition(const std::uint64_t & file,const std::size_t & offset,const std::size_t & count){
+    cursor::position_t p;
+    p.file=file;
+    p.offset=offset;
+    p.count=count;
+    advance(control::read_part);
+    rcursor.store(p);
+    switch(options.durability){
+        case ict::queue::types::fdatasync_durability:
+            rcursor.sync();
+            break;
+        case ict::queue::types::periodic_durability:
+            cursorUnsynced=true;
+            // Plik do zapisu synchronizuje strona zapisu - odczyt synchronizuje tylko plik kursora (strony kolejki działają równocześnie).
+            if (options.sync_interval_ms&&(std::chrono::milliseconds(options.sync_interval_ms)<=(std::chrono::steady_clock::now()-cursorSynced))) {
+                if (cursorUnsynced.exchange(false)) rcursor.sync();
+                cursorSynced=std::chrono::steady_clock::now();
+            }
+            break;
+        default:break;
+    }
+}
+void interface::confirmReadStream(){
+    if (readUncommitted) {
+        std::size_t offset=getReadStream().tellg();
+        storeReadPosition(readNumber,offset,rcursor.get().count+readUncommitted);
+        readAhead(offset);
+    }
+    readUncommitted=0;
+    confirmed=std::chrono::steady_clock::now();
+}
+void interface::commitReadStream(const std::size_t & count){
+    readUncommitted+=count;
+    if (options.confirm_interval||options.confirm_interval_ms){
+        bool confirm=false;
+        if (options.confirm_interval&&(options.confirm_interval<=readUncommitted)) confirm=true;
+        if (options.confirm_interval_ms&&(std::chrono::milliseconds(options.confirm_interval_ms)<=(std::chrono::steady_clock::now()-confirmed))) confirm=true;
+        if (!confirm){
+            publishRead();
+            return;
+        }
+    }
+    confirmReadStream();
+    publishRead();
+}
+void interface::syncWriteStream(){
+    if (ostream) ostream->sync();
+    if (ostream&&unflushed) advance(control::write_part);
+    if (cursorUnsynced.exchange(false)) rcursor.sync();
+    unflushed=0;
+    if (ostream) publishWrite();
+    unsynced=0;
+    synced=std::chrono::steady_clock::now();
+}
+std::chrono::steady_clock::time_point interface::syncWriteExpired(){
+    const std::chrono::steady_clock::time_point now=std::chrono::steady_clock::now();
+    const std::chrono::milliseconds interval(options.sync_interval_ms);
+    if (unsynced&&(interval<=(now-synced))){
+        if (ostream) ostream->sync();
+        unsynced=0;
+        synced=now;
+    }
+    // Zapis po upływie czasu synchronizuje się sam (zob. commitWriteStream()) - sprawdzane są tylko zapisy przed upływem czasu.
+    return (now<(synced+interval))?(synced+interval):(now+interval);
+}
+std::chrono::steady_clock::time_point interface::syncCursorExpired(){
+    const std::chrono::steady_clock::time_point now=std::chrono::steady_clock::now();
+    const std::chrono::milliseconds interval(options.sync_interval_ms);
+    if ((interval<=(now-cursorSynced))&&cursorUnsynced.exchange(false)){
+        rcursor.sync();
+        cursorSynced=now;
+    }
+    return (now<(cursorSynced+interval))?(cursorSynced+interval):(now+interval);
+}
+std::size_t interface::unsyncedSize() const{
+    return unsynced;
+}
+void interface::readAhead(const std::size_t & offset){
+    if (!options.read_ahead) return;
+    ahead.request(fpool.getPath(fpool.size()-1),offset,(1<fpool.size())?fpool.getPath(fpool.size()-2):ict::queue::types::path_t());
+}
 std::ifstream & interface::getReadStream(){
     if (!istream){
+        std::size_t offset;
         if (fpool.empty()) throw std::underflow_error("ict::queue::file::interface is empty!");
         istream.reset(new std::ifstream);
+        // Bufor musi zostać ustawiony przed otwarciem pliku.
+        if (options.read_buffer_size){
+            readBuffer.resize(options.read_buffer_size);
+            istream->rdbuf()->pubsetbuf(readBuffer.data(),readBuffer.size());
+        }
+        readNumber=fpool.getNumber(fpool.size()-1);
         istream->open(fpool.getPath(fpool.size()-1),std::ios::in|std::ios::binary);
-        istream->seekg(getPositionFromFile(),std::ios::beg);
+        rformat=detectFormat(*istream,options.format);
+        offset=std::max(getPositionFromFile(),formatBegin(rformat));
+        istream->seekg(offset,std::ios::beg);
+        readAhead(offset);
     }
     return *istream;
 }
+std::shared_ptr<const mapping> interface::mapReadStream(const std::size_t & end){
+    getReadStream();
+    if ((!readMapping)||(readMapping->size()<end)){
+        readMapping=std::make_shared<const mapping>(fpool.getPath(fpool.size()-1));
+        if (readMapping->size()<end) throw std::out_of_range("ict::queue::file::interface mapping is too small!");
+    }
+    return readMapping;
+}
 void interface::nextWriteStream(){
-    ostream.reset(nullptr);
+    bool reset=fpool.empty();
+    // Licznik odczytów zapisywany w nowym pliku musi uwzględniać wszystkie odczytane elementy.
+    confirmReadStream();
+    // Kolejka bez pliku kursora (z wcześniejszej wersji) - pozycja odczytu jest przenoszona do pliku kursora, zanim powstanie nowy plik.
+    if ((!reset)&&(!rcursor.valid())) storeReadPosition(fpool.getNumber(fpool.size()-1),getPositionFromFile(),rcursor.get().count);
+    if (ostream) ostream->seal();
+    closeWriteStream();
+    windex.reset();
+    advance(control::layout_part);
     fpool.pushFront();
+    syncDir();
+    if (reset) storeReadPosition(fpool.getNumber(0),0,rcursor.get().count);
     writeInfo();
 }
 void interface::nextReadStream(){
     istream.reset(nullptr);
+    readMapping.reset();
+    advance(control::layout_part);
     fpool.popBack();
-    writeInfo();
+    syncDir();
+    storeReadPosition(fpool.getNumber(fpool.size()-1),0,rcursor.get().count+readUncommitted);
+    readUncommitted=0;
+    confirmed=std::chrono::steady_clock::now();
+    publishRead();
 }
 std::size_t interface::size() const{
     return fpool.size();
@@ -140,32 +522,229 @@ std::size_t interface::size() const{
 bool interface::empty() const{
     return fpool.empty();
 }
+bool interface::full(const std::size_t & bytes){
+    std::size_t files=0;
+    std::size_t position;
+    if (fpool.empty()) {
+        // Nowy plik zaczyna się od nagłówka i rekordów z informacją o kolejce (zob. writeInfo()).
+        position=formatBegin(options.format)+
+            encodedSize({ict::queue::types::queue_size_record,write_sequence-rcursor.get().count},options.format)+
+            encodedSize({ict::queue::types::read_count_record,rcursor.get().count},options.format);
+        files++;
+    } else {
+        position=getWriteStream().tellp();
+    }
+    // Plik, który po zapisie przekracza maksymalny rozmiar, jest zamykany i tworzony jest nowy plik.
+    if (max_file_size<(position+bytes)) files++;
+    return fpool.full(files);
+}
 void interface::clear(){
-    ostream.reset(nullptr);
+    readUncommitted=0;
+    closeWriteStream();
     istream.reset(nullptr);
+    readMapping.reset();
+    windex.reset();
+    advance(control::layout_part);
     fpool.clear();
-    queue_size=0;
+    read_published=0;
+    // Usunięte elementy są liczone jako odczytane - numery kolejne nie są używane ponownie.
+    if (rcursor.get().count!=write_sequence) storeReadPosition(rcursor.get().file,0,write_sequence);
+    publishRead();
+}
+ict::queue::types::format_t interface::writeFormat(){
+    if (fpool.empty()) return options.format;
+    getWriteStream();
+    return wformat;
+}
+ict::queue::types::format_t interface::readFormat(){
+    getReadStream();
+    return rformat;
+}
+std::size_t interface::queueSize() const{
+    const std::uint64_t r=readSequence();
+    const std::uint64_t w=write_sequence;
+    return (r<w)?(w-r):0;
+}
+std::atomic_uint64_t & interface::writeSequence(){
+    return write_sequence;
+}
+std::uint64_t interface::readSequence() const{
+    // Strona odczytu w innym procesie mogła opublikować pozycję dalszą niż ta z pliku kursora (zob. sync()).
+    return std::max<std::uint64_t>(rcursor.get().count+readUncommitted,read_published);
+}
+void interface::indexWriteStream(const std::uint64_t & sequence,const std::size_t & offset){
+    if (!options.index_interval) return;
+    if ((!windex)||(windexNumber!=fpool.getNumber(0))){
+        // Indeks mógł zostać uzupełniony przez inny proces - odstęp jest liczony od jego ostatniego wpisu.
+        index::entry_t e;
+        windex.reset(new index(fpool.getPath(0)));
+        windexNumber=fpool.getNumber(0);
+        windexOffset=windex->last(e)?e.offset:0;
+    }
+    if ((offset<windexOffset)||((offset-windexOffset)<options.index_interval)) return;
+    if (windex->append({sequence,offset})) windexOffset=offset;
+}
+void interface::seek(const std::uint64_t & sequence){
+    std::size_t i=0;
+    std::size_t last;
+    std::uint64_t first;
+    std::size_t offset;
+    confirmReadStream();
+    if (write_sequence<sequence) throw std::out_of_range("ict::queue::file::interface sequence is out of range!");
+    if (fpool.empty()){
+        if (sequence!=write_sequence) throw std::out_of_range("ict::queue::file::interface sequence is out of range!");
+        return;
+    }
+    last=fpool.size()-1;
+    if (!getSequenceFromFile(last,first)) throw std::domain_error("ict::queue::file::interface sequence is unknown!");
+    if (sequence<first) throw std::out_of_range("ict::queue::file::interface sequence is out of range!");
+    // Wyszukiwanie binarne najnowszego pliku, którego pierwszy element ma numer nie większy od podanego (numery rosną z numerem pliku).
+    while (i<last){
+        const std::size_t middle=(i+last)/2;
+        std::uint64_t s;
+        if (!getSequenceFromFile(middle,s)) throw std::domain_error("ict::queue::file::interface sequence is unknown!");
+        if (s<=sequence){
+            last=middle;
+            first=s;
+        } else {
+            i=middle+1;
+        }
+    }
+    offset=getOffsetFromFile(last,first,sequence);
+    istream.reset(nullptr);
+    readMapping.reset();
+    if ((last+1)<fpool.size()){
+        advance(control::layout_part);
+        while ((last+1)<fpool.size()) fpool.popBack();
+        syncDir();
+    }
+    read_published=0;
+    storeReadPosition(fpool.getNumber(last),offset,sequence);
+    readUncommitted=0;
+    confirmed=std::chrono::steady_clock::now();
+    publishRead();
+}
+void interface::reload(){
+    // Niepotwierdzone odczyty są zapisywane przed przeładowaniem (inaczej zostałyby powtórzone).
+    confirmReadStream();
+    closeWriteStream();
+    istream.reset(nullptr);
+    readMapping.reset();
+    windex.reset();
+    read_published=0;
+    write_sequence=rcursor.get().count+getSizeFromFile();
+    readySize=true;
+    headChanged();
+}
+bool interface::headChanged(){
+    struct stat st;
+    std::pair<std::uint64_t,std::int64_t> h(0,0);
+    if ((!fpool.empty())&&(::stat(fpool.getPath(0).c_str(),&st)==0)){
+        h.first=st.st_size;
+        h.second=st.st_mtim.tv_sec*1000000000LL+st.st_mtim.tv_nsec;
+    }
+    if (h==head) return false;
+    head=h;
+    return true;
+}
+void interface::advance(const control::part_t & part){
+    std::uint64_t previous;
+    std::uint64_t total;
+    if (!qcontrol.advance(part,previous,total)) return;
+    known[part].compare_exchange_strong(previous,previous+1);
+    knownTotal.compare_exchange_strong(total,total+1);
 }
-std::atomic_size_t & interface::queueSize(){
-    return queue_size;
+void interface::publishWrite(){
+    std::uint64_t g;
+    // Strona znana tylko z opublikowanej pozycji (zob. sync()) nie publikuje jej ponownie.
+    if (knownValid&&qcontrol.generation(control::write_part,g)&&(g==known[control::write_part])) qcontrol.publish(control::write_part,write_sequence,g);
+}
+void interface::publishRead(){
+    std::uint64_t g;
+    if (knownValid&&qcontrol.generation(control::read_part,g)&&(g==known[control::read_part])) qcontrol.publish(control::read_part,readSequence(),g);
+}
+bool interface::sync(const control::part_t & side){
+    const control::part_t other=(side==control::write_part)?control::read_part:control::write_part;
+    std::uint64_t g;
+    std::uint64_t value;
+    if (!(knownValid&&readySize)) return false;
+    if (!qcontrol.check()){
+        // Plik blokady został utworzony od nowa - jego liczniki nie są ciągiem dalszym znanych wartości.
+        knownValid=false;
+        return false;
+    }
+    // Pula plików i stan tej strony muszą być znane - zmienia je tylko właściciel strony (pulę - przy zablokowanych obu stronach).
+    if ((!qcontrol.generation(control::layout_part,g))||(g!=known[control::layout_part])) return false;
+    if ((!qcontrol.generation(side,g))||(g!=known[side])) return false;
+    if ((!qcontrol.generation(other,g))||(g==known[other])) return true;
+    // Druga strona była zmieniana przez inny proces - potrzebna jest tylko jej opublikowana pozycja.
+    if (!qcontrol.published(other,value)) return false;
+    std::atomic_uint64_t & sequence=(other==control::write_part)?write_sequence:read_published;
+    std::uint64_t previous=sequence;
+    while ((previous<value)&&(!sequence.compare_exchange_weak(previous,value)));
+    return true;
 }
 bool interface::refresh(){
-    if (fpool.refresh()){
-        ostream.reset(nullptr);
-        istream.reset(nullptr);
-        queue_size=getSizeFromFile();
-        readySize=true;
+    std::uint64_t total=0;
+    std::uint64_t g[control::parts]={};
+    bool counted;
+    bool output;
+    if (knownValid&&readySize&&qcontrol.total(total)&&(total==knownTotal)) return false;
+    counted=qcontrol.check();
+    // Liczniki są odczytywane przed sprawdzeniem plików (licznik wszystkich zmian jako pierwszy) - zmiana w trakcie sprawdzenia zostanie wykryta przy następnym.
+    counted=counted&&qcontrol.total(total);
+    for (std::size_t k=0;k<control::parts;k++) counted=counted&&qcontrol.generation((control::part_t)k,g[k]);
+    // Wartości są ustawiane przed sprawdzeniem - zmiany plików wykonane przy przeładowaniu są zmianami tego interfejsu (zob. advance()).
+    for (std::size_t k=0;k<control::parts;k++) known[k]=g[k];
+    knownTotal=total;
+    knownValid=counted;
+    output=check();
+    {
+        // Stan opublikowany bez zmiany licznika (np. po ręcznym usunięciu plików z danymi) nie zgadza się z plikami - jest unieważniany.
+        ict::queue::types::state_t s;
+        if (qcontrol.state(s)&&((s.write_sequence!=write_sequence)||(s.read_sequence!=readSequence())||(s.files!=fpool.size()))) qcontrol.withdraw();
+    }
+    return output;
+}
+void interface::publish(){
+    std::uint64_t g;
+    flushWriteStream();
+    if (knownValid&&qcontrol.generation(control::layout_part,g)&&(g==known[control::layout_part])) qcontrol.publish(control::layout_part,fpool.size(),g);
+    publishWrite();
+    publishRead();
+}
+bool interface::state(ict::queue::types::state_t & s){
+    std::uint64_t g;
+    // Tylko odczyty z pamięci - odwzorowanie pliku blokady jest sprawdzane pod blokadą (zob. sync() i refresh()).
+    if (!qcontrol.state(s)) return false;
+    if (knownValid&&qcontrol.generation(control::write_part,g)&&(g==known[control::write_part])&&(s.write_sequence<write_sequence)){
+        // Elementy zapisane przez ten interfejs, które są jeszcze tylko w buforze strumienia.
+        s.write_sequence=write_sequence;
+        s.size=(s.read_sequence<s.write_sequence)?(s.write_sequence-s.read_sequence):0;
+    }
+    return true;
+}
+bool interface::check(){
+    // Plik kursora jest sprawdzany zawsze (odczyt w innym procesie nie zmienia plików z danymi).
+    bool moved=rcursor.changed();
+    // Pozycja odczytu zmieniona przez inny proces ma pierwszeństwo przed niepotwierdzonymi odczytami.
+    if (moved) readUncommitted=0;
+    if (fpool.refresh()||moved){
+        reload();
         return true;
     }
-    if (ostream) if (ostream->tellp()!=std::filesystem::file_size(fpool.getPath(0))){
-        ostream.reset(nullptr);
-        istream.reset(nullptr);
-        queue_size=getSizeFromFile();
-        readySize=true;
+    if (ostream){
+        if ((!unflushed)&&ostream->changed()){
+            reload();
+            return true;
+        }
+    } else if (headChanged()) {
+        // Plik do zapisu nie jest otwarty (np. proces tylko odczytuje) - zapis w innym procesie jest wykrywany po rozmiarze lub czasie modyfikacji.
+        reload();
         return true;
     }
     if (!readySize){
-        queue_size=getSizeFromFile();
+        write_sequence=rcursor.get().count+getSizeFromFile();
         readySize=true;
         return true;
     }
@@ -177,6 +756,7 @@ bool interface::refresh(){
 #ifdef ENABLE_TESTING
 #include "test.hpp"
 #include <filesystem>
+#include <thread>
 
 static ict::queue::types::path_t dirpath("/tmp/test-fileinterface");
 REGISTER_TEST(fileinterface,tc1){
@@ -185,8 +765,8 @@ REGISTER_TEST(fileinterface,tc1){
     {
         ict::queue::file::interface iface(dirpath);
         iface.nextWriteStream();
-        iface.queueSize()++;
-        iface.queueSize()++;
+        iface.writeSequence()++;
+        iface.writeSequence()++;
         iface.nextWriteStream();
         iface.nextReadStream();
         iface.nextWriteStream();
@@ -212,10 +792,8 @@ REGISTER_TEST(fileinterface,tc1){
         if (out==0){
             iface.nextWriteStream();
             iface.nextWriteStream();
-            iface.queueSize()++;
+            iface.writeSequence()++;
             iface.nextReadStream();
-            iface.queueSize()--;
-            iface.queueSize()++;
             iface.nextWriteStream();
             iface.getReadStream();
             if (iface.queueSize()!=3){
@@ -230,5 +808,36 @@ REGISTER_TEST(fileinterface,tc1){
     std::filesystem::remove_all(dirpath);
     return out;
 }
+REGISTER_TEST(fileinterface,tc2){
+    int out=0;
+    ict::queue::types::options_t options;
+    options.durability=ict::queue::types::periodic_durability;
+    options.sync_interval_ms=200;
+    std::filesystem::remove_all(dirpath);
+    std::filesystem::create_directory(dirpath);
+    {
+        ict::queue::file::interface iface(dirpath,1000000,0xffffffff,options);
+        const std::string data("abc");
+        const ict::queue::types::const_buffer_t b={data.data(),data.size()};
+        std::chrono::steady_clock::time_point next;
+        iface.nextWriteStream();
+        iface.syncWriteStream();
+        // Zapis przed upływem czasu synchronizacji - dane czekają na synchronizację.
+        iface.getWriteStream().write(&b,1);
+        iface.commitWriteStream(data.size());
+        next=iface.syncWriteExpired();
+        if ((iface.unsyncedSize()!=data.size())||((std::chrono::steady_clock::now()+std::chrono::milliseconds(options.sync_interval_ms))<next)) out=1;
+        if (out==0){
+            // Bez kolejnych zapisów dane są synchronizowane po upływie czasu.
+            std::this_thread::sleep_until(next);
+            iface.syncWriteExpired();
+            if (iface.unsyncedSize()!=0) out=2;
+        }
+        // Odczyt przed upływem czasu synchronizacji - pozycja jest synchronizowana przy następnym sprawdzeniu.
+        if ((out==0)&&((std::chrono::steady_clock::now()+std::chrono::milliseconds(options.sync_interval_ms))<iface.syncCursorExpired())) out=3;
+    }
+    std::filesystem::remove_all(dirpath);
+    return out;
+}
 #endif
 //===========================================
\ No newline at end of file
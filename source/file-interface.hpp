@@ -37,30 +37,163 @@ OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
 //============================================
 #include "types.hpp"
 #include "file-pool.hpp"
+#include "file-writer.hpp"
+#include "file-cursor.hpp"
+#include "file-control.hpp"
+#include "file-prefetch.hpp"
+#include "file-mapping.hpp"
+#include "file-checkpoint.hpp"
+#include "file-index.hpp"
 #include <fstream>
 #include <memory>
 #include <atomic>
+#include <chrono>
+#include <utility>
+#include <vector>
 //============================================
 namespace ict { namespace  queue { namespace  file {
 //===========================================
 class interface {
 private:
+    //! Typ - Położenie niepełnego lub uszkodzonego rekordu na końcu pliku do zapisu (przerwany zapis).
+    struct torn_t {
+        //! Informacja, czy taki rekord został znaleziony.
+        bool found=false;
+        //! Numer pliku do zapisu.
+        std::uint64_t file=0;
+        //! Numer i-węzła pliku do zapisu.
+        std::uint64_t inode=0;
+        //! Pozycja rekordu w pliku (nowy rozmiar pliku).
+        std::uint64_t offset=0;
+    };
     //! Informacja, czy rozmiar kolejki został zainicjowany.
     bool readySize=false;
-    //! Aktualny rozmiar kolejki.
-    std::atomic_size_t queue_size;
+    //! Numer kolejny następnego zapisanego elementu (liczba wszystkich elementów zapisanych w kolejce).
+    std::atomic_uint64_t write_sequence{0};
+    //! Numer kolejny następnego elementu do odczytu opublikowany przez stronę odczytu w innym procesie (zob. sync()).
+    std::atomic_uint64_t read_published{0};
     //! Pula plików.
     pool fpool;
-    //! Plik (strumień) do zapisu.
-    std::unique_ptr<std::ofstream> ostream;
+    //! Maksymalny rozmiar pliku.
+    const std::size_t max_file_size;
+    //! Plik do zapisu.
+    std::unique_ptr<writer> ostream;
+    //! Bufor strumienia do odczytu (musi istnieć dłużej niż strumień).
+    std::vector<char> readBuffer;
     //! Plik (strumień) do odczytu.
     std::unique_ptr<std::ifstream> istream;
+    //! Plik do odczytu odwzorowany w pamięci (zob. mapReadStream()).
+    std::shared_ptr<const mapping> readMapping;
+    //! Plik kursora odczytu (pozycja odczytu i liczba odczytanych elementów).
+    cursor rcursor;
+    //! Plik punktu kontrolnego (stan pliku do zapisu, od którego zaczyna się odczyt rozmiaru kolejki).
+    checkpoint wcheckpoint;
+    //! Liczniki zmian w plikach kolejki (w pliku blokady katalogu, wspólne dla wszystkich obiektów i procesów).
+    control qcontrol;
+    //! Wartości liczników zmian (dla każdej części bloku kontrolnego), przy których pliki kolejki zostały ostatnio sprawdzone (zob. refresh()).
+    std::atomic_uint64_t known[control::parts]={};
+    //! Wartość licznika wszystkich zmian, przy której pliki kolejki zostały ostatnio sprawdzone (zob. refresh()).
+    std::atomic_uint64_t knownTotal{0};
+    //! Informacja, że wartości liczników zmian w known i knownTotal są ważne.
+    std::atomic_bool knownValid{false};
+    //! Informacja, że plik kursora odczytu nie został zsynchronizowany z dyskiem (zmieniana przez stronę zapisu i stronę odczytu).
+    std::atomic_bool cursorUnsynced{false};
+    //! Czas ostatniej synchronizacji pliku kursora przez stronę odczytu.
+    std::chrono::steady_clock::time_point cursorSynced=std::chrono::steady_clock::now();
+    //! Numer pliku, z którego odbywa się odczyt.
+    std::uint64_t readNumber=0;
+    //! Liczba odczytanych elementów, których pozycja odczytu nie została jeszcze zapisana w pliku kursora.
+    std::size_t readUncommitted=0;
+    //! Czas ostatniego zapisu pozycji odczytu.
+    std::chrono::steady_clock::time_point confirmed;
+    //! Rozmiar i czas modyfikacji pliku do zapisu przy ostatnim przeładowaniu (gdy plik do zapisu nie jest otwarty).
+    std::pair<std::uint64_t,std::int64_t> head={0,0};
+    //! Opcje kolejki.
+    const ict::queue::types::options_t options;
+    //! Liczba bajtów zapisanych do strumienia, ale nie opróżnionych.
+    std::size_t unflushed=0;
+    //! Liczba bajtów opróżnionych, ale nie zsynchronizowanych z dyskiem.
+    std::size_t unsynced=0;
+    //! Czas ostatniej synchronizacji z dyskiem.
+    std::chrono::steady_clock::time_point synced;
+    //! Odczyt z wyprzedzeniem.
+    prefetcher ahead;
+    //! Indeks pliku do zapisu (pusty, jeśli plik do zapisu się zmienił).
+    std::unique_ptr<index> windex;
+    //! Numer pliku, którego dotyczy indeks.
+    std::uint64_t windexNumber=0;
+    //! Pozycja ostatniego wpisu w indeksie pliku do zapisu.
+    std::size_t windexOffset=0;
+    //! Niepełny lub uszkodzony rekord na końcu pliku do zapisu znaleziony przy ostatnim odczycie rozmiaru kolejki.
+    torn_t torn;
+    //! Format pliku do zapisu (ustalany przy otwarciu pliku do zapisu).
+    ict::queue::types::format_t wformat=ict::queue::types::compact_format;
+    //! Format pliku do odczytu (ustalany przy otwarciu pliku do odczytu).
+    ict::queue::types::format_t rformat=ict::queue::types::compact_format;
+    //! 
+    //! @brief Zamyka plik (strumień) do zapisu (wcześniej opróżnia go i synchronizuje, jeśli tryb trwałości tego wymaga).
+    //! 
+    void closeWriteStream();
+    //! 
+    //! @brief Synchronizuje z dyskiem zmiany w katalogu, jeśli tryb trwałości tego wymaga.
+    //! 
+    void syncDir();
+    //! 
+    //! @brief Zapisuje metadane w pliku (rozmiar kolejki i licznik odczytanych elementów z pliku kursora).
     //! 
-    //! @brief Zapisuje metadane w pliku.
+    void writeInfo();
     //! 
-    //! @param currentSize Aktualny rozmiar kolejki.
+    //! @brief Zapisuje pozycję odczytu w pliku kursora (zgodnie z trybem trwałości).
     //! 
-    void writeInfo();
+    //! @param file Numer pliku, którego dotyczy pozycja odczytu.
+    //! @param offset Pozycja odczytu w pliku.
+    //! @param count Liczba wszystkich elementów odczytanych z kolejki (numer kolejny następnego elementu do odczytu).
+    //! 
+    void storeReadPosition(const std::uint64_t & file,const std::size_t & offset,const std::size_t & count);
+    //! 
+    //! @brief Zapisuje w pliku kursora pozycję odczytu elementów, które nie zostały jeszcze potwierdzone (zob. commitReadStream()).
+    //! 
+    void confirmReadStream();
+    //! 
+    //! @brief Zgłasza pozycję odczytu do odczytu z wyprzedzeniem (jeśli jest włączony).
+    //! 
+    //! @param offset Pozycja odczytu w pliku do odczytu.
+    //! 
+    void readAhead(const std::size_t & offset);
+    //! 
+    //! @brief Zwiększa licznik zmian przed zmianą plików kolejki (także przerwana zmiana zostanie wykryta przez inne obiekty i procesy).
+    //!        Jeśli licznik nie był w międzyczasie zmieniany przez innych, stan plików nadal jest znany temu interfejsowi.
+    //! 
+    //! @param part Część bloku kontrolnego, której dotyczy zmiana.
+    //! 
+    void advance(const control::part_t & part);
+    //! 
+    //! @brief Publikuje numer kolejny następnego elementu do zapisu (tylko dane opróżnione ze strumienia są widoczne dla innych procesów).
+    //! 
+    void publishWrite();
+    //! 
+    //! @brief Publikuje numer kolejny następnego elementu do odczytu.
+    //! 
+    void publishRead();
+    //! 
+    //! @brief Sprawdza pliki kolejki (plik kursora, pulę plików i plik do zapisu) i przeładowuje interfejs, jeśli zostały zmienione.
+    //! 
+    //! @return true Interfejs został przeładowany.
+    //! @return false Interfejs nie został przeładowany.
+    //! 
+    bool check();
+    //! 
+    //! @brief Przeładowuje interfejs (zamyka pliki i odczytuje rozmiar kolejki z pliku).
+    //! 
+    void reload();
+    //! 
+    //! @brief Sprawdza, czy plik do zapisu został zmieniony (rozmiar lub czas modyfikacji) od ostatniego sprawdzenia.
+    //!        Pozwala wykryć zapis w innym procesie, gdy plik do zapisu nie jest otwarty.
+    //! 
+    //! @return true Plik został zmieniony.
+    //! @return false Plik nie został zmieniony.
+    //! 
+    bool headChanged();
     //! 
     //! @brief Odczytuje z pliku jaka powinna być pozycja odczytu.
     //! 
@@ -68,25 +201,63 @@ private:
     //! 
     std::size_t getPositionFromFile();
     //! 
-    //! @brief Odczytuje z pliku jaki powinien być rozmiar kolejki.
+    //! @brief Odczytuje z pliku jaki powinien być rozmiar kolejki. Odczyt kończy się na przerwanym zapisie (niepełny rekord
+    //!        lub rekordy z błędną sumą kontrolną na końcu pliku) - jego położenie jest zapamiętywane (zob. truncateWriteStream()).
     //! 
     //! @return Rozmiar kolejki.
     //! 
     std::size_t getSizeFromFile();
+    //! 
+    //! @brief Odczytuje dane elementu ze strumienia i sprawdza ich sumę kontrolną.
+    //! 
+    //! @param s Strumień ustawiony na początku danych elementu.
+    //! @param r Rekord elementu (payload_checksum_record).
+    //! @return true Suma kontrolna jest poprawna.
+    //! @return false Suma kontrolna jest błędna lub dane są niepełne.
+    //! 
+    static bool verifyRecord(std::istream & s,const ict::queue::types::record_t & r);
+    //! 
+    //! @brief Obcina plik do zapisu przed niepełnym lub uszkodzonym rekordem (jeśli taki został znaleziony w tym pliku),
+    //!        tak aby kolejne rekordy nie były dopisywane za nim.
+    //! 
+    void truncateWriteStream();
+    //! 
+    //! @brief Odczytuje z pliku numer kolejny pierwszego elementu w tym pliku (z rekordów zapisanych przez writeInfo()).
+    //! 
+    //! @param i Indeks pliku w puli.
+    //! @param sequence Numer kolejny pierwszego elementu w pliku.
+    //! @return true Numer został odczytany.
+    //! @return false Plik nie zaczyna się od rekordów z informacją o kolejce.
+    //! 
+    bool getSequenceFromFile(const std::size_t & i,std::uint64_t & sequence) const;
+    //! 
+    //! @brief Wyszukuje w pliku pozycję elementu o podanym numerze kolejnym (od najbliższego wpisu w indeksie pliku).
+    //! 
+    //! @param i Indeks pliku w puli.
+    //! @param first Numer kolejny pierwszego elementu w pliku.
+    //! @param sequence Numer kolejny szukanego elementu.
+    //! @return Pozycja rekordu elementu w pliku (lub koniec danych, jeśli element nie został jeszcze zapisany).
+    //! 
+    std::size_t getOffsetFromFile(const std::size_t & i,const std::uint64_t & first,const std::uint64_t & sequence) const;
 public:
     //! 
     //! @brief Konstruktor interfejsu plików.
     //! 
     //! @param dirname Ścieżka do katalogu z plikami.
     //! @param max Maksymalna liczba plików w puli.
+    //! @param opt Opcje kolejki.
     //! 
-    interface(const ict::queue::types::path_t & dirname,const std::size_t & maxFileSize=1000000,const std::size_t & maxFiles=0xffffffff);
+    interface(const ict::queue::types::path_t & dirname,const std::size_t & maxFileSize=1000000,const std::size_t & maxFiles=0xffffffff,const ict::queue::types::options_t & opt=ict::queue::types::options_t());
     //! 
-    //! @brief Zwraca plik (strumień) do zapisu.
+    //! @brief Destruktor interfejsu plików.
     //! 
-    //! @return Plik (strumień) do zapisu.
+    ~interface();
     //! 
-    std::ofstream & getWriteStream();
+    //! @brief Zwraca plik do zapisu.
+    //! 
+    //! @return Plik do zapisu.
+    //! 
+    writer & getWriteStream();
     //! 
     //! @brief Zwraca plik (strumień) do odczytu.
     //! 
@@ -94,6 +265,64 @@ public:
     //! 
     std::ifstream & getReadStream();
     //! 
+    //! @brief Zwraca plik do odczytu odwzorowany w pamięci. Odwzorowanie jest współdzielone przez widoki elementów
+    //!        i usuwane dopiero wtedy, gdy nie używa go żaden widok (także po usunięciu pliku z puli).
+    //! 
+    //! @param end Pozycja w pliku, do której musi sięgać odwzorowanie (jeśli plik urósł, tworzone jest nowe odwzorowanie).
+    //! @return Odwzorowanie pliku do odczytu.
+    //! 
+    std::shared_ptr<const mapping> mapReadStream(const std::size_t & end);
+    //! 
+    //! @brief Rozpoczyna zapis do pliku do zapisu - zwiększa licznik zmian przed zapisem danych (zob. advance()).
+    //! 
+    void beginWriteStream();
+    //! 
+    //! @brief Zatwierdza operację zapisu zgodnie z trybem trwałości (opróżnia strumień i/lub synchronizuje go z dyskiem).
+    //! 
+    //! @param bytes Liczba bajtów zapisanych w ramach operacji.
+    //! 
+    void commitWriteStream(const std::size_t & bytes);
+    //! 
+    //! @brief Opróżnia plik (strumień) do zapisu, jeśli zawiera niezapisane dane.
+    //! 
+    void flushWriteStream();
+    //! 
+    //! @brief Zapisuje pozycję odczytu niepotwierdzonych jeszcze odczytów w pliku kursora i opróżnia plik do zapisu.
+    //! 
+    void flush();
+    //! 
+    //! @brief Opróżnia plik (strumień) do zapisu i synchronizuje go z dyskiem (fdatasync).
+    //! 
+    void syncWriteStream();
+    //! 
+    //! @brief Synchronizuje z dyskiem plik do zapisu, jeśli od ostatniej synchronizacji minęło sync_interval_ms milisekund,
+    //!        a są w nim dane niezsynchronizowane z dyskiem (periodic_durability - także wtedy, gdy nie ma kolejnych zapisów).
+    //! 
+    //! @return Czas, w którym trzeba sprawdzić ponownie.
+    //! 
+    std::chrono::steady_clock::time_point syncWriteExpired();
+    //! 
+    //! @brief Synchronizuje z dyskiem plik kursora, jeśli od ostatniej synchronizacji przez stronę odczytu minęło sync_interval_ms
+    //!        milisekund, a pozycja odczytu nie została zsynchronizowana (periodic_durability - także wtedy, gdy nie ma kolejnych odczytów).
+    //! 
+    //! @return Czas, w którym trzeba sprawdzić ponownie.
+    //! 
+    std::chrono::steady_clock::time_point syncCursorExpired();
+    //! 
+    //! @brief Zwraca liczbę bajtów opróżnionych, ale nie zsynchronizowanych z dyskiem.
+    //! 
+    //! @return Liczba bajtów.
+    //! 
+    std::size_t unsyncedSize() const;
+    //! 
+    //! @brief Zatwierdza odczyt elementów - zapisuje aktualną pozycję odczytu w pliku kursora (pliki z danymi nie są zmieniane).
+    //!        Jeśli ustawiono confirm_interval lub confirm_interval_ms, pozycja jest zapisywana dopiero po zebraniu
+    //!        odpowiedniej liczby odczytów lub po upływie odpowiedniego czasu (do tego czasu jest tylko w pamięci).
+    //! 
+    //! @param count Liczba odczytanych elementów.
+    //! 
+    void commitReadStream(const std::size_t & count);
+    //! 
     //! @brief Przechodzi do kolejnego pliku do zapisu.
     //! 
     //! @param currentSize Aktualny rozmiar kolejki.
@@ -119,17 +348,90 @@ public:
     //! 
     bool empty() const;
     //! 
+    //! @brief Sprawdza, czy zapis podanej liczby bajtów przekroczyłby maksymalną liczbę plików w puli.
+    //! 
+    //! @param bytes Liczba bajtów do zapisania.
+    //! @return true Zapis nie jest możliwy.
+    //! @return false Zapis jest możliwy.
+    //! 
+    bool full(const std::size_t & bytes);
+    //! 
     //! @brief Usuwa wszystkie pliki z puli.
     //! 
     void clear();
     //! 
-    //! @brief Udostępnia aktualny rozmiar kolejki.
+    //! @brief Zwraca format pliku do zapisu (format, w którym należy kodować rekordy dopisywane do tego pliku).
+    //! 
+    //! @return Format pliku do zapisu.
+    //! 
+    ict::queue::types::format_t writeFormat();
+    //! 
+    //! @brief Zwraca format pliku do odczytu (format, w którym należy dekodować rekordy odczytywane z getReadStream()).
+    //! 
+    //! @return Format pliku do odczytu.
+    //! 
+    ict::queue::types::format_t readFormat();
+    //! 
+    //! @brief Zwraca aktualny rozmiar kolejki (różnica numerów kolejnych elementów do zapisu i do odczytu).
     //! 
     //! @return Aktualny rozmiar kolejki. 
     //! 
-    std::atomic_size_t & queueSize();
+    std::size_t queueSize() const;
+    //! 
+    //! @brief Udostępnia numer kolejny następnego zapisanego elementu.
+    //! 
+    //! @return Numer kolejny następnego zapisanego elementu. 
+    //! 
+    std::atomic_uint64_t & writeSequence();
+    //! 
+    //! @brief Zwraca numer kolejny następnego elementu do odczytu (liczba wszystkich odczytanych elementów, także niepotwierdzonych).
+    //! 
+    //! @return Numer kolejny następnego elementu do odczytu.
+    //! 
+    std::uint64_t readSequence() const;
+    //! 
+    //! @brief Dodaje element do indeksu pliku do zapisu, jeśli od ostatniego wpisu zapisano co najmniej index_interval bajtów.
+    //! 
+    //! @param sequence Numer kolejny elementu.
+    //! @param offset Pozycja rekordu elementu w pliku do zapisu.
+    //! 
+    void indexWriteStream(const std::uint64_t & sequence,const std::size_t & offset);
+    //! 
+    //! @brief Zmienia pozycję odczytu - następnym odczytanym elementem będzie element o podanym numerze kolejnym.
+    //!        Pliki zawierające tylko wcześniejsze elementy są usuwane. Pozycja może zostać cofnięta w obrębie najstarszego pliku.
+    //! 
+    //! @param sequence Numer kolejny elementu.
+    //! 
+    void seek(const std::uint64_t & sequence);
+    //! 
+    //! @brief Publikuje stan kolejki w pliku blokady katalogu (obie strony kolejki muszą być zablokowane) - opróżnia plik do zapisu
+    //!        i publikuje te części stanu, które są aktualne. Stan jest ważny, dopóki liczniki zmian nie zostaną zmienione przez inne
+    //!        obiekty lub procesy (zob. state()).
+    //! 
+    void publish();
+    //! 
+    //! @brief Odczytuje opublikowany stan kolejki bez blokowania katalogu. Elementy zapisane przez ten interfejs, ale jeszcze
+    //!        nie opróżnione ze strumienia (nie są opublikowane), są doliczane.
+    //! 
+    //! @param s Stan kolejki.
+    //! @return true Stan został odczytany.
+    //! @return false Stan nie jest ważny (trzeba go odczytać pod blokadą).
+    //! 
+    bool state(ict::queue::types::state_t & s);
+    //! 
+    //! @brief Przygotowuje operację na jednej stronie kolejki (zablokowana jest tylko ta strona). Stan puli plików i stan tej strony
+    //!        muszą być znane interfejsowi (liczniki zmian nie zmieniły się od ostatniego sprawdzenia plików, poza zmianami wykonanymi
+    //!        przez ten interfejs) - stan drugiej strony jest wtedy tylko uzupełniany jej opublikowaną pozycją (bez sprawdzania plików).
+    //! 
+    //! @param side Strona kolejki (control::write_part lub control::read_part).
+    //! @return true Operacja może zostać wykonana.
+    //! @return false Pliki trzeba sprawdzić (zob. refresh()).
+    //! 
+    bool sync(const control::part_t & side);
     //! 
-    //! @brief Sprawdza, czy interfejs wymaga przeładowania i przeładowuje, jeśli jest to potrzebne. 
+    //! @brief Sprawdza, czy interfejs wymaga przeładowania i przeładowuje, jeśli jest to potrzebne. Pliki kolejki są sprawdzane
+    //!        tylko wtedy, gdy licznik wszystkich zmian zmienił się od ostatniego sprawdzenia - w przeciwnym razie jest to jeden odczyt
+    //!        z pamięci. Dopiero przy sprawdzaniu plików jest sprawdzane, czy plik blokady nie został utworzony od nowa.
     //! 
     bool refresh();
 };
@@ -0,0 +1,112 @@
+//! @file
+//! @brief File mapping module - Source file.
+//! @author Mariusz Ornowski (mariusz.ornowski@ict-project.pl)
+//! @date 2026
+//! @copyright ICT-Project Mariusz Ornowski (ict-project.pl)
+/* **************************************************************
+Copyright (c) 2026, ICT-Project Mariusz Ornowski (ict-project.pl)
+All rights reserved.
+
+Redistribution and use in source and binary forms, with or without
+modification, are permitted provided that the following conditions
+are met:
+
+1. Redistributions of source code must retain the above copyright
+notice, this list of conditions and the following disclaimer.
+2. Redistributions in binary form must reproduce the above copyright
+notice, this list of conditions and the following disclaimer in the
+documentation and/or other materials provided with the distribution.
+3. Neither the name of the ICT-Project Mariusz Ornowski nor the names
+of its contributors may be used to endorse or promote products
+derived from this software without specific prior written permission.
+
+THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+"AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR
+A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT
+HOLDER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,
+SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT
+LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,
+DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY
+THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+(INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+**************************************************************/
+//============================================
+#include "file-mapping.hpp"
+#include <system_error>
+#include <cerrno>
+#include <unistd.h>
+#include <fcntl.h>
+#include <sys/stat.h>
+#include <sys/mman.h>
+//============================================
+namespace ict { namespace  queue { namespace  file {
+//============================================
+mapping::mapping(const ict::queue::types::path_t & path){
+    struct stat st;
+    int fd=::open(path.c_str(),O_RDONLY|O_CLOEXEC);
+    if (fd<0) throw std::system_error(errno,std::generic_category(),"ict::queue::file::mapping open failed!");
+    if (::fstat(fd,&st)<0){
+        int e=errno;
+        ::close(fd);
+        throw std::system_error(e,std::generic_category(),"ict::queue::file::mapping fstat failed!");
+    }
+    length=st.st_size;
+    if (length){
+        void * p=::mmap(nullptr,length,PROT_READ,MAP_SHARED,fd,0);
+        if (p==MAP_FAILED){
+            int e=errno;
+            ::close(fd);
+            throw std::system_error(e,std::generic_category(),"ict::queue::file::mapping mmap failed!");
+        }
+        data=(const char *)p;
+    }
+    // Odwzorowanie nie wymaga otwartego pliku.
+    ::close(fd);
+}
+mapping::~mapping(){
+    if (data) ::munmap((void*)data,length);
+}
+//===========================================
+} } }
+//===========================================
+#ifdef ENABLE_TESTING
+#include "test.hpp"
+#include <filesystem>
+#include <fstream>
+
+static ict::queue::types::path_t dirpath("/tmp/test-filemapping");
+REGISTER_TEST(filemapping,tc1){
+    int out=0;
+    std::filesystem::remove_all(dirpath);
+    std::filesystem::create_directory(dirpath);
+    {
+        const std::string data("Ala ma kota!");
+        {
+            std::ofstream f(dirpath+"/1.dat",std::ios::out|std::ios::binary);
+            f<<data;
+        }
+        ict::queue::file::mapping m(dirpath+"/1.dat");
+        if (std::string(m.get(),m.size())!=data) out=1;
+        // Odwzorowanie jest ważne po usunięciu pliku.
+        std::filesystem::remove(dirpath+"/1.dat");
+        if ((out==0)&&(std::string(m.get(),m.size())!=data)) out=2;
+    }
+    if (out==0){
+        std::ofstream f(dirpath+"/2.dat",std::ios::out|std::ios::binary);
+        f.close();
+        ict::queue::file::mapping m(dirpath+"/2.dat");
+        if ((m.size()!=0)||(m.get()!=nullptr)) out=3;
+    }
+    if (out==0){
+        try {
+            ict::queue::file::mapping m(dirpath+"/3.dat");
+            out=4;
+        } catch (std::system_error & e) {}
+    }
+    std::filesystem::remove_all(dirpath);
+    return out;
+}
+#endif
+//===========================================
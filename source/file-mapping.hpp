@@ -0,0 +1,84 @@
+//! @file
+//! @brief File mapping module - header file.
+//! @author Mariusz Ornowski (mariusz.ornowski@ict-project.pl)
+//! @date 2026
+//! @copyright ICT-Project Mariusz Ornowski (ict-project.pl)
+/* **************************************************************
+Copyright (c) 2026, ICT-Project Mariusz Ornowski (ict-project.pl)
+All rights reserved.
+
+Redistribution and use in source and binary forms, with or without
+modification, are permitted provided that the following conditions
+are met:
+
+1. Redistributions of source code must retain the above copyright
+notice, this list of conditions and the following disclaimer.
+2. Redistributions in binary form must reproduce the above copyright
+notice, this list of conditions and the following disclaimer in the
+documentation and/or other materials provided with the distribution.
+3. Neither the name of the ICT-Project Mariusz Ornowski nor the names
+of its contributors may be used to endorse or promote products
+derived from this software without specific prior written permission.
+
+THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+"AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR
+A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT
+HOLDER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,
+SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT
+LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,
+DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY
+THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+(INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+**************************************************************/
+#ifndef _FILE_MAPPING_HEADER
+#define _FILE_MAPPING_HEADER
+//============================================
+#include "types.hpp"
+#include <string>
+//============================================
+namespace ict { namespace  queue { namespace  file {
+//===========================================
+//! Plik odwzorowany w pamięci tylko do odczytu (mmap) - odwzorowanie jest usuwane w destruktorze.
+//! Odwzorowanie pozostaje ważne także po usunięciu pliku z katalogu.
+class mapping {
+private:
+    //! Początek odwzorowania.
+    const char * data=nullptr;
+    //! Rozmiar odwzorowania.
+    std::size_t length=0;
+public:
+    //! 
+    //! @brief Konstruktor - odwzorowuje cały plik.
+    //! 
+    //! @param path Ścieżka do pliku.
+    //! 
+    mapping(const ict::queue::types::path_t & path);
+    mapping(const mapping &)=delete;
+    mapping & operator=(const mapping &)=delete;
+    //! 
+    //! @brief Destruktor (usuwa odwzorowanie).
+    //! 
+    ~mapping();
+    //! 
+    //! @brief Zwraca początek odwzorowania.
+    //! 
+    //! @return Wskaźnik do początku pliku.
+    //! 
+    const char * get() const {
+        return data;
+    }
+    //! 
+    //! @brief Zwraca rozmiar odwzorowania.
+    //! 
+    //! @return Rozmiar pliku w chwili odwzorowania.
+    //! 
+    std::size_t size() const {
+        return length;
+    }
+};
+//===========================================
+} } }
+//============================================
+#endif
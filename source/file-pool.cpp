@@ -34,12 +34,15 @@ OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
 **************************************************************/
 //============================================
 #include "file-pool.hpp"
+#include "file-index.hpp"
 #include <map>
 #include <regex>
 #include <fstream>
 #include <sstream>
 #include <iomanip>
 #include <filesystem>
+#include <unistd.h>
+#include <fcntl.h>
 //============================================
 namespace ict { namespace  queue { namespace  file {
 //============================================
@@ -51,12 +54,19 @@ const ict::queue::types::path_t & pool::getPath(const std::size_t & index) const
     if (index<list.size()) return list.at(index).path;
     throw std::out_of_range("ict::queue::file::pool out of range!");
 }
+std::uint64_t pool::getNumber(const std::size_t & index) const{
+    if (index<list.size()) return list.at(index).number;
+    throw std::out_of_range("ict::queue::file::pool out of range!");
+}
 std::size_t pool::size() const {
     return list.size();
 }
 bool pool::empty() const {
     return list.empty();
 }
+bool pool::full(const std::size_t & files) const {
+    return max_files<(list.size()+files);
+}
 void pool::pushFront(){
     if (std::filesystem::is_directory(dir)){
         item_t i;
@@ -150,10 +160,13 @@ void pool::loadFileList(){
 void pool::createFile(const ict::queue::types::path_t & path) const {
     std::ofstream f;
     if (std::filesystem::exists(path)) std::filesystem::remove(path);
+    // Indeks pozostały po wcześniejszym pliku o tym samym numerze nie dotyczy nowego pliku.
+    std::filesystem::remove(index::getPath(path));
     f.open(path,std::ios::out);
 }
 void pool::removeFile(const ict::queue::types::path_t & path) const {
     std::filesystem::remove(path);
+    std::filesystem::remove(index::getPath(path));
 }
 bool pool::refresh(){
     if (list.empty()) {
@@ -175,6 +188,12 @@ bool pool::refresh(){
     }
     return false;
 }
+void pool::sync() const{
+    int fd=::open(dir.c_str(),O_RDONLY|O_DIRECTORY);
+    if (fd<0) return;
+    ::fsync(fd);
+    ::close(fd);
+}
 //===========================================
 } } }
 //===========================================
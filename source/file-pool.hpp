@@ -79,13 +79,13 @@ private:
     //! 
     void loadFileList();
     //! 
-    //! @brief Tworzy nowy plik.
+    //! @brief Tworzy nowy plik (usuwa też indeks pozostały po wcześniejszym pliku o tym samym numerze).
     //! 
     //! @param path Ścieżka do pliku.
     //! 
     void createFile(const ict::queue::types::path_t & path) const;
     //! 
-    //! @brief Usuwa istniejący plik.
+    //! @brief Usuwa istniejący plik (razem z jego indeksem).
     //! 
     //! @param path Ścieżka do pliku.
     //! 
@@ -106,6 +106,13 @@ public:
     //! 
     const ict::queue::types::path_t & getPath(const std::size_t & index=0) const;
     //! 
+    //! @brief Zwraca numer pliku o podanym indeksie.
+    //! 
+    //! @param index Indeks pliku.
+    //! @return Numer pliku. 
+    //! 
+    std::uint64_t getNumber(const std::size_t & index=0) const;
+    //! 
     //! @brief Zwraca aktualny rozmiar puli plików.
     //! 
     //! @return Rozmiar puli plików.
@@ -119,6 +126,14 @@ public:
     //! 
     bool empty() const;
     //! 
+    //! @brief Sprawdza, czy dodanie podanej liczby plików przekroczyłoby maksymalną liczbę plików w puli.
+    //! 
+    //! @param files Liczba plików do dodania.
+    //! @return true Jest pełna.
+    //! @return false Nie jest pełna.
+    //! 
+    bool full(const std::size_t & files=1) const;
+    //! 
     //! @brief Dodaje nowy plik do puli (na początku).
     //! 
     void pushFront();
@@ -134,6 +149,10 @@ public:
     //! @brief Sprawdza, czy pula wymaga przeładowania i przeładowuje, jeśli jest tp potrzebne. 
     //!
     bool refresh();
+    //! 
+    //! @brief Synchronizuje z dyskiem zmiany w katalogu z plikami (utworzenie i usunięcie plików).
+    //! 
+    void sync() const;
 };
 //===========================================
 } } }
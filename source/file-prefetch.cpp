@@ -0,0 +1,151 @@
+//! @file
+//! @brief File prefetch module - Source file.
+//! @author Mariusz Ornowski (mariusz.ornowski@ict-project.pl)
+//! @date 2026
+//! @copyright ICT-Project Mariusz Ornowski (ict-project.pl)
+/* **************************************************************
+Copyright (c) 2026, ICT-Project Mariusz Ornowski (ict-project.pl)
+All rights reserved.
+
+Redistribution and use in source and binary forms, with or without
+modification, are permitted provided that the following conditions
+are met:
+
+1. Redistributions of source code must retain the above copyright
+notice, this list of conditions and the following disclaimer.
+2. Redistributions in binary form must reproduce the above copyright
+notice, this list of conditions and the following disclaimer in the
+documentation and/or other materials provided with the distribution.
+3. Neither the name of the ICT-Project Mariusz Ornowski nor the names
+of its contributors may be used to endorse or promote products
+derived from this software without specific prior written permission.
+
+THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+"AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR
+A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT
+HOLDER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,
+SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT
+LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,
+DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY
+THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+(INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+**************************************************************/
+//============================================
+#include "file-prefetch.hpp"
+#include <algorithm>
+#include <unistd.h>
+#include <fcntl.h>
+//============================================
+namespace ict { namespace  queue { namespace  file {
+//============================================
+//! Rozmiar bufora, do którego wątek odczytuje dane.
+static const std::size_t chunk_size=1<<17;
+prefetcher::~prefetcher(){
+    {
+        std::lock_guard<std::mutex> lock(mutex);
+        stop=true;
+    }
+    cond.notify_all();
+    if (thread.joinable()) thread.join();
+}
+void prefetcher::request(const ict::queue::types::path_t & file,const std::size_t & position,const ict::queue::types::path_t & nextFile){
+    if (!window) return;
+    {
+        std::lock_guard<std::mutex> lock(mutex);
+        if ((file==path)&&(offset<=position)&&(position+window/2<requested)) return;
+        path=file;
+        offset=position;
+        next=nextFile;
+        requested=position+window;
+        pending=true;
+        if (!thread.joinable()) thread=std::thread(&prefetcher::run,this);
+    }
+    cond.notify_one();
+}
+std::size_t prefetcher::readRange(const ict::queue::types::path_t & file,std::size_t from,std::size_t length,std::vector<char> & buffer){
+    std::size_t out=0;
+    int fd=::open(file.c_str(),O_RDONLY|O_CLOEXEC);
+    if (fd<0) return 0;
+    ::posix_fadvise(fd,from,length,POSIX_FADV_SEQUENTIAL);
+    while (out<length){
+        ssize_t n=::pread(fd,buffer.data(),std::min(buffer.size(),length-out),from+out);
+        if (n<=0) break;
+        out+=n;
+        bytes+=n;
+    }
+    ::close(fd);
+    return out;
+}
+void prefetcher::run(){
+    std::vector<char> buffer(chunk_size);
+    while (true){
+        ict::queue::types::path_t file;
+        ict::queue::types::path_t nextFile;
+        std::size_t position;
+        std::size_t length;
+        {
+            std::unique_lock<std::mutex> lock(mutex);
+            cond.wait(lock,[this]{return stop||pending;});
+            if (stop) return;
+            pending=false;
+            file=path;
+            nextFile=next;
+            position=offset;
+        }
+        length=readRange(file,position,window,buffer);
+        // Koniec pliku - reszta okna jest odczytywana z następnego pliku.
+        if ((length<window)&&(!nextFile.empty())) readRange(nextFile,0,window-length,buffer);
+    }
+}
+//===========================================
+} } }
+//===========================================
+#ifdef ENABLE_TESTING
+#include "test.hpp"
+#include <filesystem>
+#include <fstream>
+#include <chrono>
+
+static ict::queue::types::path_t dirpath("/tmp/test-fileprefetch");
+REGISTER_TEST(fileprefetch,tc1){
+    int out=0;
+    std::filesystem::remove_all(dirpath);
+    std::filesystem::create_directory(dirpath);
+    {
+        const std::string data(1000,'x');
+        for (const char * name : {"/1.dat","/2.dat"}){
+            std::ofstream f(dirpath+name,std::ios::out|std::ios::binary);
+            f<<data;
+        }
+        ict::queue::file::prefetcher p(1500);
+        // Odczyt od pozycji 200: 800 bajtów z pierwszego pliku i 700 bajtów z następnego.
+        p.request(dirpath+"/1.dat",200,dirpath+"/2.dat");
+        for (std::size_t k=0;(k<1000)&&(p.prefetched()<1500);k++) std::this_thread::sleep_for(std::chrono::milliseconds(1));
+        if (p.prefetched()!=1500){
+            std::cerr<<"prefetched="<<p.prefetched()<<std::endl;
+            out=1;
+        }
+        // Pozycja w pierwszej połowie okna - wątek nie jest budzony.
+        p.request(dirpath+"/1.dat",600,dirpath+"/2.dat");
+        std::this_thread::sleep_for(std::chrono::milliseconds(20));
+        if ((out==0)&&(p.prefetched()!=1500)) out=2;
+        // Pozycja za połową okna - odczyt kolejnego okna (40 bajtów z pierwszego pliku i cały następny plik).
+        p.request(dirpath+"/1.dat",960,dirpath+"/2.dat");
+        for (std::size_t k=0;(k<1000)&&(p.prefetched()<2540);k++) std::this_thread::sleep_for(std::chrono::milliseconds(1));
+        if ((out==0)&&(p.prefetched()!=2540)){
+            std::cerr<<"prefetched="<<p.prefetched()<<std::endl;
+            out=3;
+        }
+    }
+    {
+        ict::queue::file::prefetcher p(0);
+        p.request(dirpath+"/1.dat",0,"");
+        if ((out==0)&&(p.prefetched()!=0)) out=4;
+    }
+    std::filesystem::remove_all(dirpath);
+    return out;
+}
+#endif
+//===========================================
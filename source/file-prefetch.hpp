@@ -0,0 +1,120 @@
+//! @file
+//! @brief File prefetch module - header file.
+//! @author Mariusz Ornowski (mariusz.ornowski@ict-project.pl)
+//! @date 2026
+//! @copyright ICT-Project Mariusz Ornowski (ict-project.pl)
+/* **************************************************************
+Copyright (c) 2026, ICT-Project Mariusz Ornowski (ict-project.pl)
+All rights reserved.
+
+Redistribution and use in source and binary forms, with or without
+modification, are permitted provided that the following conditions
+are met:
+
+1. Redistributions of source code must retain the above copyright
+notice, this list of conditions and the following disclaimer.
+2. Redistributions in binary form must reproduce the above copyright
+notice, this list of conditions and the following disclaimer in the
+documentation and/or other materials provided with the distribution.
+3. Neither the name of the ICT-Project Mariusz Ornowski nor the names
+of its contributors may be used to endorse or promote products
+derived from this software without specific prior written permission.
+
+THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+"AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR
+A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT
+HOLDER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,
+SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT
+LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,
+DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY
+THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+(INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+**************************************************************/
+#ifndef _FILE_PREFETCH_HEADER
+#define _FILE_PREFETCH_HEADER
+//============================================
+#include "types.hpp"
+#include <string>
+#include <vector>
+#include <mutex>
+#include <condition_variable>
+#include <thread>
+#include <atomic>
+//============================================
+namespace ict { namespace  queue { namespace  file {
+//===========================================
+//! Odczyt z wyprzedzeniem - wątek, który wczytuje do pamięci podręcznej systemu dane za pozycją odczytu (także z następnego pliku),
+//! zanim zostaną odczytane przez kolejkę.
+class prefetcher {
+private:
+    //! Liczba bajtów odczytywanych z wyprzedzeniem (0 - wyłączone).
+    const std::size_t window;
+    //! Wątek odczytujący z wyprzedzeniem.
+    std::thread thread;
+    //! Mutex dla żądań odczytu.
+    std::mutex mutex;
+    //! Zmienna warunkowa, na której czeka wątek.
+    std::condition_variable cond;
+    //! Informacja, że wątek ma się zakończyć.
+    bool stop=false;
+    //! Informacja, że jest żądanie do obsłużenia.
+    bool pending=false;
+    //! Ścieżka do pliku, z którego odbywa się odczyt.
+    ict::queue::types::path_t path;
+    //! Pozycja odczytu w pliku.
+    std::size_t offset=0;
+    //! Ścieżka do następnego pliku do odczytu (pusta, jeśli plik do odczytu jest też plikiem do zapisu).
+    ict::queue::types::path_t next;
+    //! Koniec zakresu, o którego odczyt poproszono ostatnio (w pliku path).
+    std::size_t requested=0;
+    //! Liczba bajtów odczytanych z wyprzedzeniem.
+    std::atomic_size_t bytes{0};
+    //! 
+    //! @brief Pętla wątku odczytującego z wyprzedzeniem.
+    //! 
+    void run();
+    //! 
+    //! @brief Odczytuje fragment pliku (dane trafiają do pamięci podręcznej systemu).
+    //! 
+    //! @param file Ścieżka do pliku.
+    //! @param from Pozycja w pliku, od której zaczyna się odczyt.
+    //! @param length Maksymalna liczba bajtów do odczytania.
+    //! @param buffer Bufor na odczytane dane.
+    //! @return Liczba odczytanych bajtów (mniejsza od length, jeśli osiągnięto koniec pliku).
+    //! 
+    std::size_t readRange(const ict::queue::types::path_t & file,std::size_t from,std::size_t length,std::vector<char> & buffer);
+public:
+    //! 
+    //! @brief Konstruktor.
+    //! 
+    //! @param readAhead Liczba bajtów odczytywanych z wyprzedzeniem (0 - wyłączone, wątek nie jest uruchamiany).
+    //! 
+    prefetcher(const std::size_t & readAhead):window(readAhead){}
+    //! 
+    //! @brief Destruktor (zatrzymuje wątek).
+    //! 
+    ~prefetcher();
+    //! 
+    //! @brief Zgłasza aktualną pozycję odczytu. Wątek (uruchamiany przy pierwszym wywołaniu) jest budzony dopiero wtedy,
+    //!        gdy pozycja odczytu zbliża się do końca zakresu odczytanego z wyprzedzeniem (przeszła połowę okna).
+    //! 
+    //! @param file Ścieżka do pliku, z którego odbywa się odczyt.
+    //! @param position Pozycja odczytu w pliku.
+    //! @param nextFile Ścieżka do następnego pliku do odczytu (pusta, jeśli nie ma następnego pliku).
+    //! 
+    void request(const ict::queue::types::path_t & file,const std::size_t & position,const ict::queue::types::path_t & nextFile);
+    //! 
+    //! @brief Zwraca liczbę bajtów odczytanych z wyprzedzeniem.
+    //! 
+    //! @return Liczba bajtów.
+    //! 
+    std::size_t prefetched() const {
+        return bytes;
+    }
+};
+//===========================================
+} } }
+//============================================
+#endif
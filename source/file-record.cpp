@@ -0,0 +1,295 @@
+//! @file
+//! @brief File record module - Source file.
+//! @author Mariusz Ornowski (mariusz.ornowski@ict-project.pl)
+//! @date 2026
+//! @copyright ICT-Project Mariusz Ornowski (ict-project.pl)
+/* **************************************************************
+Copyright (c) 2026, ICT-Project Mariusz Ornowski (ict-project.pl)
+All rights reserved.
+
+Redistribution and use in source and binary forms, with or without
+modification, are permitted provided that the following conditions
+are met:
+
+1. Redistributions of source code must retain the above copyright
+notice, this list of conditions and the following disclaimer.
+2. Redistributions in binary form must reproduce the above copyright
+notice, this list of conditions and the following disclaimer in the
+documentation and/or other materials provided with the distribution.
+3. Neither the name of the ICT-Project Mariusz Ornowski nor the names
+of its contributors may be used to endorse or promote products
+derived from this software without specific prior written permission.
+
+THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+"AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR
+A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT
+HOLDER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,
+SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT
+LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,
+DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY
+THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+(INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+**************************************************************/
+#include "file-record.hpp"
+#include <fstream>
+#include <cstring>
+//============================================
+namespace ict { namespace  queue { namespace  file {
+//============================================
+//! Sygnatura nagłówka pliku w formacie compact_format.
+static const char format_magic[4]={'I','C','T','Q'};
+//! Maksymalny rozmiar liczby o zmiennej długości (64 bity po 7 bitów w bajcie).
+static const std::size_t max_varint_size=10;
+//! Liczba bitów typu rekordu w liczbie o zmiennej długości (pozostałe bity to dane rekordu).
+static const unsigned type_bits=4;
+//! 
+//! @brief Zwraca rozmiar liczby o zmiennej długości.
+//! 
+//! @param value Liczba.
+//! @return Rozmiar w bajtach.
+//! 
+static std::size_t varintSize(std::uint64_t value){
+    std::size_t output=1;
+    while (0x80<=value){
+        value>>=7;
+        output++;
+    }
+    return output;
+}
+//! 
+//! @brief Koduje liczbę o zmiennej długości (7 bitów w bajcie, najstarszy bit oznacza kolejny bajt).
+//! 
+//! @param value Liczba.
+//! @param width Minimalny rozmiar w bajtach (dopełniany bajtami z zerowymi bitami danych).
+//! @param output Bufor na zakodowaną liczbę.
+//! @return Rozmiar w bajtach.
+//! 
+static std::size_t encodeVarint(std::uint64_t value,const std::size_t & width,char * output){
+    std::size_t n=0;
+    do {
+        unsigned char c=value&0x7f;
+        value>>=7;
+        if (value||((n+1)<width)) c|=0x80;
+        output[n++]=c;
+    } while (value||(n<width));
+    return n;
+}
+//! 
+//! @brief Zwraca wartość typu rekordu w formacie compact_format.
+//! 
+//! @param r Rekord.
+//! @return Liczba z typem i danymi rekordu.
+//! 
+static std::uint64_t compactValue(const ict::queue::types::record_t & r){
+    return (((std::uint64_t)r.data)<<type_bits)|(std::uint64_t)r.type;
+}
+std::size_t formatBegin(const ict::queue::types::format_t & format){
+    return (format==ict::queue::types::compact_format)?format_header_size:0;
+}
+std::size_t encodeFormat(const ict::queue::types::format_t & format,char * output){
+    if (format!=ict::queue::types::compact_format) return 0;
+    std::memset(output,0,format_header_size);
+    std::memcpy(output,format_magic,sizeof(format_magic));
+    output[sizeof(format_magic)]=(char)format;
+    return format_header_size;
+}
+ict::queue::types::format_t detectFormat(std::istream & s,const ict::queue::types::format_t & empty){
+    char header[format_header_size];
+    std::size_t n;
+    s.clear();
+    s.seekg(0,std::ios::beg);
+    s.read(header,format_header_size);
+    n=s.gcount();
+    s.clear();
+    s.seekg(0,std::ios::beg);
+    if (!n) return empty;
+    // Plik w formacie legacy_format zaczyna się od typu rekordu, który nigdy nie jest zgodny z sygnaturą.
+    if (std::memcmp(header,format_magic,std::min(n,sizeof(format_magic)))) return ict::queue::types::legacy_format;
+    // Niepełny nagłówek - zapis nowego pliku w trakcie.
+    if (n<=sizeof(format_magic)) return ict::queue::types::compact_format;
+    if (header[sizeof(format_magic)]!=(char)ict::queue::types::compact_format) throw std::domain_error("ict::queue::file format version is not supported!");
+    return ict::queue::types::compact_format;
+}
+ict::queue::types::format_t detectFormat(const ict::queue::types::path_t & path,const ict::queue::types::format_t & empty){
+    std::ifstream s(path,std::ios::in|std::ios::binary);
+    if (!s) return empty;
+    return detectFormat(s,empty);
+}
+std::size_t encodeRecord(const ict::queue::types::record_t & r,const ict::queue::types::format_t & format,char * output){
+    std::size_t n;
+    if (format!=ict::queue::types::compact_format){
+        std::memcpy(output,&r,sizeof(ict::queue::types::record_t));
+        return sizeof(ict::queue::types::record_t);
+    }
+    n=encodeVarint(compactValue(r),1,output);
+    if (r.type==ict::queue::types::payload_checksum_record){
+        // Suma kontrolna jest zapisywana w kolejności little-endian (niezależnie od platformy).
+        for (unsigned k=0;k<4;k++) output[n++]=(char)((r.checksum>>(8*k))&0xff);
+    }
+    return n;
+}
+std::size_t encodedSize(const ict::queue::types::record_t & r,const ict::queue::types::format_t & format){
+    if (format!=ict::queue::types::compact_format) return sizeof(ict::queue::types::record_t);
+    return varintSize(compactValue(r))+((r.type==ict::queue::types::payload_checksum_record)?4:0);
+}
+std::size_t encodePadding(const std::size_t & size,const ict::queue::types::format_t & format,char * output){
+    if (format!=ict::queue::types::compact_format){
+        if (size<sizeof(ict::queue::types::record_t)) return 0;
+        return encodeRecord({ict::queue::types::padding_record,size-sizeof(ict::queue::types::record_t)},format,output);
+    }
+    if (!size) return 0;
+    {
+        // Rozmiar rekordu zależy od liczby pomijanych bajtów - rekord jest kodowany na maksymalnym potrzebnym rozmiarze.
+        const std::size_t width=varintSize(compactValue({ict::queue::types::padding_record,size}));
+        return encodeVarint(compactValue({ict::queue::types::padding_record,size-width}),width,output);
+    }
+}
+std::size_t decodeRecord(const char * data,const std::size_t & size,const ict::queue::types::format_t & format,ict::queue::types::record_t & r){
+    std::uint64_t value=0;
+    std::size_t n=0;
+    if (format!=ict::queue::types::compact_format){
+        if (size<sizeof(ict::queue::types::record_t)) return 0;
+        std::memcpy(&r,data,sizeof(ict::queue::types::record_t));
+        return sizeof(ict::queue::types::record_t);
+    }
+    for (;;){
+        unsigned char c;
+        if ((size<=n)||(max_varint_size<=n)) return 0;
+        c=data[n];
+        value|=((std::uint64_t)(c&0x7f))<<(7*n);
+        n++;
+        if (!(c&0x80)) break;
+    }
+    r.type=(ict::queue::types::record_type_t)(value&((1<<type_bits)-1));
+    r.data=value>>type_bits;
+    r.checksum=0;
+    // Zerowy typ nie jest zapisywany w tym formacie (zera to np. niezapisane miejsce za danymi).
+    if (r.type==ict::queue::types::payload_size_record) return 0;
+    if (r.type==ict::queue::types::payload_checksum_record){
+        if (size<(n+4)) return 0;
+        for (unsigned k=0;k<4;k++) r.checksum|=((std::uint32_t)(unsigned char)data[n++])<<(8*k);
+    }
+    return n;
+}
+std::size_t readRecord(std::istream & s,const ict::queue::types::format_t & format,ict::queue::types::record_t & r){
+    char buffer[max_record_size];
+    std::size_t n=0;
+    std::size_t output;
+    if (format!=ict::queue::types::compact_format){
+        s.read((char*)&r,sizeof(ict::queue::types::record_t));
+        return s?sizeof(ict::queue::types::record_t):0;
+    }
+    for (;;){
+        const int c=s.get();
+        if (c==std::char_traits<char>::eof()) return 0;
+        buffer[n++]=(char)c;
+        if (!(c&0x80)) break;
+        if (max_varint_size<=n) break;
+    }
+    if ((buffer[0]&((1<<type_bits)-1))==ict::queue::types::payload_checksum_record){
+        s.read(buffer+n,4);
+        if (!s) return 0;
+        n+=4;
+    }
+    output=decodeRecord(buffer,n,format,r);
+    if (!output) s.setstate(std::ios::failbit);
+    return output;
+}
+//===========================================
+} } }
+//===========================================
+#ifdef ENABLE_TESTING
+#include "test.hpp"
+#include <sstream>
+
+REGISTER_TEST(filerecord,tc1){
+    int out=0;
+    const ict::queue::types::format_t formats[2]={ict::queue::types::legacy_format,ict::queue::types::compact_format};
+    const std::size_t sizes[]={0,1,7,8,40,127,128,2047,2048,1<<20,((std::size_t)1)<<40};
+    for (const ict::queue::types::format_t & f : formats){
+        for (int t=ict::queue::types::read_pointer_record;(out==0)&&(t<=ict::queue::types::payload_checksum_record);t++){
+            for (const std::size_t & size : sizes){
+                const ict::queue::types::record_t r((ict::queue::types::record_type_t)t,size,(t==ict::queue::types::payload_checksum_record)?0xe3069283:0);
+                ict::queue::types::record_t d;
+                char buffer[ict::queue::file::max_record_size];
+                const std::size_t n=ict::queue::file::encodeRecord(r,f,buffer);
+                if ((n!=ict::queue::file::encodedSize(r,f))||(ict::queue::file::max_record_size<n)){
+                    std::cerr<<"format="<<f<<" type="<<t<<" size="<<size<<" n="<<n<<std::endl;
+                    out=1;
+                    break;
+                }
+                if ((ict::queue::file::decodeRecord(buffer,n,f,d)!=n)||(d.type!=r.type)||(d.data!=r.data)||(d.checksum!=r.checksum)){
+                    std::cerr<<"format="<<f<<" type="<<t<<" size="<<size<<std::endl;
+                    out=2;
+                    break;
+                }
+                // Niepełny rekord nie jest odczytywany.
+                if (ict::queue::file::decodeRecord(buffer,n-1,f,d)){
+                    out=3;
+                    break;
+                }
+                {
+                    std::stringstream s;
+                    s.write(buffer,n);
+                    s.write(buffer,n-1);
+                    if ((ict::queue::file::readRecord(s,f,d)!=n)||(d.type!=r.type)||(d.data!=r.data)||(d.checksum!=r.checksum)){
+                        out=4;
+                        break;
+                    }
+                    if (ict::queue::file::readRecord(s,f,d)||s){
+                        out=5;
+                        break;
+                    }
+                }
+            }
+        }
+    }
+    if (out==0){
+        // Element o rozmiarze 40 bajtów - rekord z sumą kontrolną zajmuje 6 bajtów zamiast 16.
+        const ict::queue::types::record_t r(ict::queue::types::payload_checksum_record,40,1);
+        if (ict::queue::file::encodedSize(r,ict::queue::types::compact_format)!=6) out=6;
+        if (ict::queue::file::encodedSize(r,ict::queue::types::legacy_format)!=16) out=7;
+    }
+    for (const ict::queue::types::format_t & f : formats){
+        for (std::size_t size=0;(out==0)&&(size<20000);size++){
+            char buffer[ict::queue::file::max_record_size];
+            ict::queue::types::record_t d;
+            const std::size_t n=ict::queue::file::encodePadding(size,f,buffer);
+            if (!n){
+                if (size&&((f==ict::queue::types::compact_format)||(sizeof(ict::queue::types::record_t)<=size))) out=8;
+                continue;
+            }
+            if ((ict::queue::file::decodeRecord(buffer,n,f,d)!=n)||(d.type!=ict::queue::types::padding_record)||((n+d.data)!=size)){
+                std::cerr<<"format="<<f<<" size="<<size<<" n="<<n<<std::endl;
+                out=9;
+            }
+        }
+    }
+    if (out==0){
+        char header[ict::queue::file::format_header_size];
+        const std::size_t n=ict::queue::file::encodeFormat(ict::queue::types::compact_format,header);
+        const std::string h(header,n);
+        std::stringstream empty,legacy(std::string(16,(char)ict::queue::types::queue_size_record)),compact(h+"\x35"),partial(h.substr(0,3)),unknown(h.substr(0,4)+"\x7f");
+        if ((n!=ict::queue::file::format_header_size)||(ict::queue::file::formatBegin(ict::queue::types::compact_format)!=n)||ict::queue::file::formatBegin(ict::queue::types::legacy_format)){
+            out=10;
+        } else if (ict::queue::file::detectFormat(empty,ict::queue::types::legacy_format)!=ict::queue::types::legacy_format){
+            out=11;
+        } else if (ict::queue::file::detectFormat(legacy,ict::queue::types::compact_format)!=ict::queue::types::legacy_format){
+            out=12;
+        } else if ((ict::queue::file::detectFormat(compact,ict::queue::types::legacy_format)!=ict::queue::types::compact_format)||(compact.tellg()!=0)){
+            out=13;
+        } else if (ict::queue::file::detectFormat(partial,ict::queue::types::legacy_format)!=ict::queue::types::compact_format){
+            out=14;
+        } else {
+            try {
+                ict::queue::file::detectFormat(unknown,ict::queue::types::compact_format);
+                out=15;
+            } catch (const std::domain_error &) {}
+        }
+    }
+    return out;
+}
+#endif
+//===========================================
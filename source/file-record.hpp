@@ -0,0 +1,126 @@
+//! @file
+//! @brief File record module - header file.
+//! @author Mariusz Ornowski (mariusz.ornowski@ict-project.pl)
+//! @date 2026
+//! @copyright ICT-Project Mariusz Ornowski (ict-project.pl)
+/* **************************************************************
+Copyright (c) 2026, ICT-Project Mariusz Ornowski (ict-project.pl)
+All rights reserved.
+
+Redistribution and use in source and binary forms, with or without
+modification, are permitted provided that the following conditions
+are met:
+
+1. Redistributions of source code must retain the above copyright
+notice, this list of conditions and the following disclaimer.
+2. Redistributions in binary form must reproduce the above copyright
+notice, this list of conditions and the following disclaimer in the
+documentation and/or other materials provided with the distribution.
+3. Neither the name of the ICT-Project Mariusz Ornowski nor the names
+of its contributors may be used to endorse or promote products
+derived from this software without specific prior written permission.
+
+THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+"AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR
+A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT
+HOLDER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,
+SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT
+LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,
+DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY
+THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+(INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+**************************************************************/
+#ifndef _FILE_RECORD_HEADER
+#define _FILE_RECORD_HEADER
+//============================================
+#include "types.hpp"
+#include <istream>
+//============================================
+namespace ict { namespace  queue { namespace  file {
+//===========================================
+//! Rozmiar nagłówka pliku w formacie compact_format (sygnatura "ICTQ", wersja formatu i 3 bajty zarezerwowane).
+const std::size_t format_header_size=8;
+//! Maksymalny rozmiar zakodowanego rekordu (w każdym formacie).
+const std::size_t max_record_size=16;
+//! 
+//! @brief Zwraca pozycję pierwszego rekordu w pliku w podanym formacie (rozmiar nagłówka pliku).
+//! 
+//! @param format Format pliku.
+//! @return Pozycja pierwszego rekordu.
+//! 
+std::size_t formatBegin(const ict::queue::types::format_t & format);
+//! 
+//! @brief Koduje nagłówek pliku w podanym formacie (plik w formacie legacy_format nie ma nagłówka).
+//! 
+//! @param format Format pliku.
+//! @param output Bufor na nagłówek (co najmniej format_header_size bajtów).
+//! @return Rozmiar nagłówka.
+//! 
+std::size_t encodeFormat(const ict::queue::types::format_t & format,char * output);
+//! 
+//! @brief Rozpoznaje format pliku po jego nagłówku. Pozycja strumienia jest ustawiana na początek pliku.
+//! 
+//! @param s Strumień pliku.
+//! @param empty Format przyjmowany dla pustego pliku (nagłówek zostanie zapisany przy otwarciu pliku do zapisu).
+//! @return Format pliku.
+//! 
+ict::queue::types::format_t detectFormat(std::istream & s,const ict::queue::types::format_t & empty);
+//! 
+//! @brief Rozpoznaje format pliku po jego nagłówku.
+//! 
+//! @param path Ścieżka do pliku.
+//! @param empty Format przyjmowany dla pustego (lub nieistniejącego) pliku.
+//! @return Format pliku.
+//! 
+ict::queue::types::format_t detectFormat(const ict::queue::types::path_t & path,const ict::queue::types::format_t & empty);
+//! 
+//! @brief Koduje rekord w podanym formacie.
+//! 
+//! @param r Rekord.
+//! @param format Format pliku.
+//! @param output Bufor na zakodowany rekord (co najmniej max_record_size bajtów).
+//! @return Rozmiar zakodowanego rekordu.
+//! 
+std::size_t encodeRecord(const ict::queue::types::record_t & r,const ict::queue::types::format_t & format,char * output);
+//! 
+//! @brief Zwraca rozmiar rekordu zakodowanego w podanym formacie.
+//! 
+//! @param r Rekord.
+//! @param format Format pliku.
+//! @return Rozmiar zakodowanego rekordu.
+//! 
+std::size_t encodedSize(const ict::queue::types::record_t & r,const ict::queue::types::format_t & format);
+//! 
+//! @brief Koduje rekord wypełnienia (padding_record), który razem z pomijanymi bajtami zajmuje dokładnie podaną liczbę bajtów.
+//! 
+//! @param size Liczba bajtów do wypełnienia.
+//! @param format Format pliku.
+//! @param output Bufor na zakodowany rekord (co najmniej max_record_size bajtów).
+//! @return Rozmiar zakodowanego rekordu (0 - wypełnienie jest za małe na rekord w tym formacie).
+//! 
+std::size_t encodePadding(const std::size_t & size,const ict::queue::types::format_t & format,char * output);
+//! 
+//! @brief Dekoduje rekord z pamięci.
+//! 
+//! @param data Zakodowany rekord.
+//! @param size Liczba dostępnych bajtów.
+//! @param format Format pliku.
+//! @param r Odczytany rekord.
+//! @return Rozmiar zakodowanego rekordu (0 - rekord jest niepełny lub niepoprawny).
+//! 
+std::size_t decodeRecord(const char * data,const std::size_t & size,const ict::queue::types::format_t & format,ict::queue::types::record_t & r);
+//! 
+//! @brief Odczytuje rekord ze strumienia.
+//! 
+//! @param s Strumień pliku (jeśli rekord jest niepełny lub niepoprawny, ustawiany jest stan błędu).
+//! @param format Format pliku.
+//! @param r Odczytany rekord.
+//! @return Rozmiar zakodowanego rekordu (0 - rekord jest niepełny lub niepoprawny).
+//! 
+std::size_t readRecord(std::istream & s,const ict::queue::types::format_t & format,ict::queue::types::record_t & r);
+//===========================================
+} } }
+//============================================
+#endif
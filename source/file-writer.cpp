@@ -0,0 +1,734 @@
+//! @file
+//! @brief File writer module - Source file.
+//! @author Mariusz Ornowski (mariusz.ornowski@ict-project.pl)
+//! @date 2026
+//! @copyright ICT-Project Mariusz Ornowski (ict-project.pl)
+/* **************************************************************
+Copyright (c) 2026, ICT-Project Mariusz Ornowski (ict-project.pl)
+All rights reserved.
+
+Redistribution and use in source and binary forms, with or without
+modification, are permitted provided that the following conditions
+are met:
+
+1. Redistributions of source code must retain the above copyright
+notice, this list of conditions and the following disclaimer.
+2. Redistributions in binary form must reproduce the above copyright
+notice, this list of conditions and the following disclaimer in the
+documentation and/or other materials provided with the distribution.
+3. Neither the name of the ICT-Project Mariusz Ornowski nor the names
+of its contributors may be used to endorse or promote products
+derived from this software without specific prior written permission.
+
+THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+"AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR
+A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT
+HOLDER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,
+SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT
+LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,
+DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY
+THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+(INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+**************************************************************/
+//============================================
+#include "file-writer.hpp"
+#include <system_error>
+#include <filesystem>
+#include <algorithm>
+#include <atomic>
+#include <cstring>
+#include <cstdlib>
+#include <new>
+#include <cerrno>
+#include <unistd.h>
+#include <fcntl.h>
+#include <sys/uio.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#ifdef ENABLE_IO_URING
+#include <list>
+#include <deque>
+#include <iterator>
+#include <sys/syscall.h>
+#include <linux/io_uring.h>
+#endif
+//============================================
+namespace ict { namespace  queue { namespace  file {
+//============================================
+//! Maksymalna liczba buforów przekazywanych w jednym wywołaniu writev().
+static const std::size_t max_iovec=64;
+bool writer::changed() const{
+    return tellp()!=std::filesystem::file_size(path);
+}
+//! 
+//! @brief Zapisuje nagłówek pliku, jeśli plik jest pusty (nowy plik).
+//! 
+//! @param path Ścieżka do pliku.
+//! @param format Format pliku.
+//! 
+static void writeHeader(const ict::queue::types::path_t & path,const ict::queue::types::format_t & format){
+    char header[format_header_size];
+    const std::size_t n=encodeFormat(format,header);
+    struct stat st;
+    int fd;
+    if ((!n)||(::stat(path.c_str(),&st)!=0)||st.st_size) return;
+    fd=::open(path.c_str(),O_WRONLY|O_CLOEXEC);
+    if (fd<0) throw std::system_error(errno,std::generic_category(),"ict::queue::file::writer open failed!");
+    if (::pwrite(fd,header,n,0)!=(ssize_t)n){
+        int e=errno;
+        ::close(fd);
+        throw std::system_error(e,std::generic_category(),"ict::queue::file::writer write failed!");
+    }
+    ::close(fd);
+}
+std::unique_ptr<writer> writer::create(const ict::queue::types::path_t & path,const std::size_t & maxFileSize,const ict::queue::types::format_t & format,const ict::queue::types::options_t & options){
+    writeHeader(path,format);
+    switch(options.backend){
+        case ict::queue::types::descriptor_backend:
+            return std::unique_ptr<writer>(new descriptor_writer(path));
+        case ict::queue::types::mmap_backend:
+            return std::unique_ptr<writer>(new mmap_writer(path,maxFileSize,format));
+        case ict::queue::types::direct_backend:
+            try {
+                return std::unique_ptr<writer>(new direct_writer(path,format));
+            } catch (const std::system_error &) {
+                // System plików nie obsługuje O_DIRECT - zapis przez deskryptor pliku.
+            }
+            return std::unique_ptr<writer>(new descriptor_writer(path));
+        case ict::queue::types::uring_backend:
+#ifdef ENABLE_IO_URING
+            try {
+                return std::unique_ptr<writer>(new uring_writer(path,options.durability!=ict::queue::types::buffered_durability));
+            } catch (const std::system_error &) {
+                // io_uring nie jest dostępny - zapis przez deskryptor pliku.
+            }
+#endif
+            return std::unique_ptr<writer>(new descriptor_writer(path));
+        case ict::queue::types::stream_backend:
+        default:break;
+    }
+    switch(options.durability){
+        case ict::queue::types::fdatasync_durability:
+        case ict::queue::types::periodic_durability:
+            return std::unique_ptr<writer>(new stream_writer(path,true));
+        default:break;
+    }
+    return std::unique_ptr<writer>(new stream_writer(path,false));
+}
+stream_writer::stream_writer(const ict::queue::types::path_t & filename,bool syncable):writer(filename){
+    stream.open(path,std::ios::out|std::ios::binary|std::ios::app);
+    stream.seekp(0,std::ios::end);
+    if (syncable) fd=::open(path.c_str(),O_WRONLY);
+}
+stream_writer::~stream_writer(){
+    if (0<=fd) ::close(fd);
+}
+void stream_writer::write(const ict::queue::types::const_buffer_t * buffers,const std::size_t & count){
+    for (std::size_t k=0;k<count;k++){
+        if (buffers[k].size) stream.write(buffers[k].data,buffers[k].size);
+    }
+}
+std::size_t stream_writer::tellp() const{
+    return stream.tellp();
+}
+void stream_writer::flush(){
+    stream.flush();
+}
+void stream_writer::sync(){
+    stream.flush();
+    if (0<=fd) ::fdatasync(fd);
+}
+descriptor_writer::descriptor_writer(const ict::queue::types::path_t & filename):writer(filename){
+    fd=::open(path.c_str(),O_WRONLY|O_APPEND|O_CLOEXEC);
+    if (fd<0) throw std::system_error(errno,std::generic_category(),"ict::queue::file::descriptor_writer open failed!");
+    off_t end=::lseek(fd,0,SEEK_END);
+    if (0<end) position=end;
+}
+descriptor_writer::~descriptor_writer(){
+    if (0<=fd) ::close(fd);
+}
+void descriptor_writer::write(const ict::queue::types::const_buffer_t * buffers,const std::size_t & count){
+    struct iovec iov[max_iovec];
+    std::size_t k=0;
+    while (k<count){
+        int n=0;
+        std::size_t total=0;
+        for (;(k<count)&&(n<(int)max_iovec);k++){
+            if (buffers[k].size){
+                iov[n].iov_base=(void*)buffers[k].data;
+                iov[n].iov_len=buffers[k].size;
+                total+=buffers[k].size;
+                n++;
+            }
+        }
+        struct iovec * i=iov;
+        while (total){
+            ssize_t w=::writev(fd,i,n);
+            if (w<0) {
+                if (errno==EINTR) continue;
+                throw std::system_error(errno,std::generic_category(),"ict::queue::file::descriptor_writer write failed!");
+            }
+            position+=w;
+            total-=w;
+            while (n&&(i->iov_len<=(std::size_t)w)){
+                w-=i->iov_len;
+                i++;
+                n--;
+            }
+            if (n&&w){
+                i->iov_base=((char*)i->iov_base)+w;
+                i->iov_len-=w;
+            }
+        }
+    }
+}
+std::size_t descriptor_writer::tellp() const{
+    return position;
+}
+void descriptor_writer::flush(){
+}
+void descriptor_writer::sync(){
+    ::fdatasync(fd);
+}
+mmap_writer::mmap_writer(const ict::queue::types::path_t & filename,const std::size_t & maxFileSize,const ict::queue::types::format_t & fileFormat):writer(filename),format(fileFormat){
+    struct stat st;
+    markerSize=encodeRecord({ict::queue::types::end_of_data_record,0},format,marker);
+    fd=::open(path.c_str(),O_RDWR|O_CLOEXEC);
+    if (fd<0) throw std::system_error(errno,std::generic_category(),"ict::queue::file::mmap_writer open failed!");
+    if (::fstat(fd,&st)){
+        int e=errno;
+        ::close(fd);
+        throw std::system_error(e,std::generic_category(),"ict::queue::file::mmap_writer fstat failed!");
+    }
+    try {
+        if (st.st_size) reserve(st.st_size);
+        position=std::min(formatBegin(format),capacity);
+        // Szukanie końca danych (rekord końca danych lub koniec ostatniego pełnego rekordu).
+        while (position<capacity){
+            ict::queue::types::record_t r;
+            const std::size_t n=decodeRecord(base+position,capacity-position,format,r);
+            if ((!n)||(r.type==ict::queue::types::end_of_data_record)||(ict::queue::types::payload_checksum_record<r.type)) break;
+            if ((r.type==ict::queue::types::payload_size_record)||(r.type==ict::queue::types::payload_checksum_record)||(r.type==ict::queue::types::padding_record)){
+                if ((capacity-position-n)<r.data) break;
+                position+=r.data;
+            }
+            position+=n;
+        }
+        // Rekord końca danych jest zapisywany przed alokacją, by za danymi nigdy nie było samych zer.
+        if (::pwrite(fd,marker,markerSize,position)!=(ssize_t)markerSize){
+            throw std::system_error(errno,std::generic_category(),"ict::queue::file::mmap_writer write failed!");
+        }
+        reserve(std::max(maxFileSize,position+markerSize));
+    } catch (...) {
+        if (base) ::munmap(base,capacity);
+        ::close(fd);
+        throw;
+    }
+    synced=position;
+}
+mmap_writer::~mmap_writer(){
+    if (base) ::munmap(base,capacity);
+    if (0<=fd) ::close(fd);
+}
+void mmap_writer::reserve(const std::size_t & size){
+    if (base&&(size<=capacity)) return;
+    if (capacity<size){
+        int e=::posix_fallocate(fd,0,size);
+        if (e) throw std::system_error(e,std::generic_category(),"ict::queue::file::mmap_writer fallocate failed!");
+    }
+    if (base) ::munmap(base,capacity);
+    base=nullptr;
+    capacity=0;
+    void * m=::mmap(nullptr,size,PROT_READ|PROT_WRITE,MAP_SHARED,fd,0);
+    if (m==MAP_FAILED) throw std::system_error(errno,std::generic_category(),"ict::queue::file::mmap_writer mmap failed!");
+    base=(char*)m;
+    capacity=size;
+}
+void mmap_writer::write(const ict::queue::types::const_buffer_t * buffers,const std::size_t & count){
+    // Typ rekordu jest na początku rekordu w każdym formacie (w formacie compact_format w pierwszym bajcie).
+    const std::size_t type_size=std::min(sizeof(ict::queue::types::record_type_t),markerSize);
+    char header[max_record_size];
+    std::size_t total=0;
+    std::size_t offset=0;
+    std::size_t skip;
+    char * p;
+    if (!base) throw std::domain_error("ict::queue::file::mmap_writer is sealed!");
+    for (std::size_t k=0;k<count;k++) total+=buffers[k].size;
+    if (!total) return;
+    reserve(position+total+markerSize);
+    p=base+position;
+    // Początek danych (w miejscu dotychczasowego rekordu końca danych) jest zapisywany na końcu,
+    // więc czytający nigdy nie zobaczy niepełnych danych.
+    skip=(markerSize<=total)?markerSize:0;
+    for (std::size_t k=0;k<count;k++){
+        const char * d=buffers[k].data;
+        std::size_t s=buffers[k].size;
+        if (offset<skip){
+            std::size_t n=std::min(skip-offset,s);
+            std::memcpy(header+offset,d,n);
+            offset+=n;
+            d+=n;
+            s-=n;
+        }
+        if (s) std::memcpy(p+offset,d,s);
+        offset+=s;
+    }
+    std::memcpy(p+total,marker,markerSize);
+    if (skip){
+        std::atomic_thread_fence(std::memory_order_release);
+        std::memcpy(p+type_size,header+type_size,skip-type_size);
+        std::atomic_thread_fence(std::memory_order_release);
+        std::memcpy(p,header,type_size);
+    }
+    position+=total;
+}
+std::size_t mmap_writer::tellp() const{
+    return position;
+}
+void mmap_writer::flush(){
+}
+void mmap_writer::sync(){
+    if (base){
+        static const std::size_t page=::sysconf(_SC_PAGESIZE);
+        std::size_t start=synced-(synced%page);
+        ::msync(base+start,position+markerSize-start,MS_SYNC);
+        synced=position;
+    } else {
+        ::fdatasync(fd);
+    }
+}
+bool mmap_writer::changed() const{
+    struct stat st;
+    if (!base) return true;
+    if (::fstat(fd,&st)) return true;
+    if ((std::size_t)st.st_size!=capacity) return true;
+    // Typ rekordu na pozycji zapisu (inny proces mógł zastąpić rekord końca danych).
+    return std::memcmp(base+position,marker,std::min(sizeof(ict::queue::types::record_type_t),markerSize))!=0;
+}
+void mmap_writer::seal(){
+    if (base){
+        ::munmap(base,capacity);
+        base=nullptr;
+        capacity=0;
+        if (::ftruncate(fd,position)) throw std::system_error(errno,std::generic_category(),"ict::queue::file::mmap_writer truncate failed!");
+    }
+}
+//! Rozmiar bloku (wyrównanie zapisów O_DIRECT).
+static const std::size_t block_size=4096;
+//! Rozmiar wyrównanego bufora (bez miejsca na wypełnienie).
+static const std::size_t staging_size=256*block_size;
+direct_writer::direct_writer(const ict::queue::types::path_t & filename,const ict::queue::types::format_t & fileFormat):writer(filename),format(fileFormat){
+    struct stat st;
+    fd=::open(path.c_str(),O_RDWR|O_DIRECT|O_CLOEXEC);
+    if (fd<0) throw std::system_error(errno,std::generic_category(),"ict::queue::file::direct_writer open failed!");
+    staging=(char*)std::aligned_alloc(block_size,staging_size+2*block_size);
+    if (!staging){
+        ::close(fd);
+        throw std::bad_alloc();
+    }
+    if (::fstat(fd,&st)){
+        int e=errno;
+        std::free(staging);
+        ::close(fd);
+        throw std::system_error(e,std::generic_category(),"ict::queue::file::direct_writer fstat failed!");
+    }
+    offset=st.st_size-(st.st_size%block_size);
+    length=st.st_size%block_size;
+    if (length){
+        // Ostatni, niepełny blok (np. plik zapisany wcześniej innym sposobem zapisu) jest wczytywany do bufora.
+        if (::pread(fd,staging,block_size,offset)<(ssize_t)length){
+            int e=errno;
+            std::free(staging);
+            ::close(fd);
+            throw std::system_error(e,std::generic_category(),"ict::queue::file::direct_writer read failed!");
+        }
+    }
+}
+direct_writer::~direct_writer(){
+    try {
+        flush();
+    } catch (...) {}
+    std::free(staging);
+    if (0<=fd) ::close(fd);
+}
+void direct_writer::writeStaging(const std::size_t & size){
+    std::size_t done=0;
+    while (done<size){
+        ssize_t w=::pwrite(fd,staging+done,size-done,offset+done);
+        if (w<0) {
+            if (errno==EINTR) continue;
+            throw std::system_error(errno,std::generic_category(),"ict::queue::file::direct_writer write failed!");
+        }
+        done+=w;
+    }
+    offset+=size;
+    length=0;
+}
+void direct_writer::write(const ict::queue::types::const_buffer_t * buffers,const std::size_t & count){
+    for (std::size_t k=0;k<count;k++){
+        const char * d=buffers[k].data;
+        std::size_t s=buffers[k].size;
+        while (s){
+            std::size_t n=std::min(s,staging_size-length);
+            std::memcpy(staging+length,d,n);
+            length+=n;
+            d+=n;
+            s-=n;
+            if (length==staging_size) writeStaging(staging_size);
+        }
+    }
+}
+std::size_t direct_writer::tellp() const{
+    return offset+length;
+}
+void direct_writer::flush(){
+    std::size_t padding;
+    if (!length) return;
+    padding=(block_size-(length%block_size))%block_size;
+    if (padding){
+        char r[max_record_size];
+        std::size_t n=encodePadding(padding,format,r);
+        // Wypełnienie mniejsze niż rekord wypełnienia jest powiększane o cały blok.
+        if (!n){
+            padding+=block_size;
+            n=encodePadding(padding,format,r);
+        }
+        std::memset(staging+length,0,padding);
+        std::memcpy(staging+length,r,n);
+        length+=padding;
+    }
+    writeStaging(length);
+}
+void direct_writer::sync(){
+    flush();
+    ::fdatasync(fd);
+}
+#ifdef ENABLE_IO_URING
+//! Liczba pozycji w pierścieniu zgłoszeń io_uring.
+static const unsigned queue_depth=64;
+//! Maksymalna liczba buforów w jednej operacji zapisu.
+static const std::size_t max_uring_iovec=1024;
+//! Identyfikator zgłoszenia synchronizacji z dyskiem (zgłoszenia zapisu mają adres zapisu).
+static const std::uint64_t datasync_request=0;
+struct uring_writer::ring_t {
+    //! Typ - Zapis (wysłany do jądra lub oczekujący na wysłanie).
+    struct request_t {
+        //! Pozycja w pliku pierwszego niezapisanego bajtu.
+        std::size_t offset;
+        //! Liczba niezapisanych bajtów.
+        std::size_t size;
+        //! Bufory z niezapisanymi danymi.
+        std::vector<struct iovec> iov;
+        //! Kopia danych (zapis, który nie może korzystać z buforów wywołującego).
+        std::vector<char> copy;
+        //! Pozycja zapisu na liście zapisów.
+        std::list<request_t>::iterator self;
+    };
+    int fd=-1;
+    unsigned entries=0;
+    void * sq=MAP_FAILED;
+    std::size_t sq_size=0;
+    void * cq=MAP_FAILED;
+    std::size_t cq_size=0;
+    struct io_uring_sqe * sqes=(struct io_uring_sqe *)MAP_FAILED;
+    std::size_t sqes_size=0;
+    unsigned * sq_tail=nullptr;
+    unsigned * sq_mask=nullptr;
+    unsigned * sq_array=nullptr;
+    unsigned * cq_head=nullptr;
+    unsigned * cq_tail=nullptr;
+    unsigned * cq_mask=nullptr;
+    struct io_uring_cqe * cqes=nullptr;
+    //! Wszystkie niezakończone zapisy (adresy na liście się nie zmieniają, więc są identyfikatorami zgłoszeń).
+    std::list<request_t> requests;
+    //! Zapisy oczekujące na wysłanie (nowe i pozostałe części zapisów wykonanych częściowo).
+    std::deque<request_t*> queued;
+    //! Liczba zgłoszeń wysłanych do jądra, których wyniki nie zostały jeszcze odebrane.
+    unsigned inflight=0;
+    //! Kod pierwszego błędu (zgłaszany po zakończeniu wszystkich wysłanych zgłoszeń).
+    int error=0;
+    //! Informacja, że ostatnia synchronizacja z dyskiem została wykonana.
+    bool synced=false;
+    ring_t(){
+        struct io_uring_params p;
+        std::memset(&p,0,sizeof(p));
+        fd=::syscall(__NR_io_uring_setup,queue_depth,&p);
+        if (fd<0) throw std::system_error(errno,std::generic_category(),"ict::queue::file::uring_writer io_uring_setup failed!");
+        entries=p.sq_entries;
+        sq_size=p.sq_off.array+p.sq_entries*sizeof(unsigned);
+        cq_size=p.cq_off.cqes+p.cq_entries*sizeof(struct io_uring_cqe);
+        if (p.features&IORING_FEAT_SINGLE_MMAP) sq_size=cq_size=std::max(sq_size,cq_size);
+        sq=::mmap(nullptr,sq_size,PROT_READ|PROT_WRITE,MAP_SHARED|MAP_POPULATE,fd,IORING_OFF_SQ_RING);
+        if (sq==MAP_FAILED) throw std::system_error(errno,std::generic_category(),"ict::queue::file::uring_writer mmap failed!");
+        if (p.features&IORING_FEAT_SINGLE_MMAP){
+            cq=sq;
+        } else {
+            cq=::mmap(nullptr,cq_size,PROT_READ|PROT_WRITE,MAP_SHARED|MAP_POPULATE,fd,IORING_OFF_CQ_RING);
+            if (cq==MAP_FAILED) throw std::system_error(errno,std::generic_category(),"ict::queue::file::uring_writer mmap failed!");
+        }
+        sqes_size=p.sq_entries*sizeof(struct io_uring_sqe);
+        sqes=(struct io_uring_sqe *)::mmap(nullptr,sqes_size,PROT_READ|PROT_WRITE,MAP_SHARED|MAP_POPULATE,fd,IORING_OFF_SQES);
+        if (sqes==MAP_FAILED) throw std::system_error(errno,std::generic_category(),"ict::queue::file::uring_writer mmap failed!");
+        sq_tail=(unsigned*)((char*)sq+p.sq_off.tail);
+        sq_mask=(unsigned*)((char*)sq+p.sq_off.ring_mask);
+        sq_array=(unsigned*)((char*)sq+p.sq_off.array);
+        cq_head=(unsigned*)((char*)cq+p.cq_off.head);
+        cq_tail=(unsigned*)((char*)cq+p.cq_off.tail);
+        cq_mask=(unsigned*)((char*)cq+p.cq_off.ring_mask);
+        cqes=(struct io_uring_cqe *)((char*)cq+p.cq_off.cqes);
+    }
+    ~ring_t(){
+        // Jądro może jeszcze odczytywać bufory wysłanych zapisów.
+        try {
+            while (inflight) reap(true);
+        } catch (...) {}
+        if (sqes!=MAP_FAILED) ::munmap(sqes,sqes_size);
+        if ((cq!=MAP_FAILED)&&(cq!=sq)) ::munmap(cq,cq_size);
+        if (sq!=MAP_FAILED) ::munmap(sq,sq_size);
+        if (0<=fd) ::close(fd);
+    }
+    //! 
+    //! @brief Dodaje zgłoszenie do pierścienia (bez wysyłania do jądra).
+    //! 
+    struct io_uring_sqe * prepare(unsigned & tail){
+        unsigned index=tail&(*sq_mask);
+        struct io_uring_sqe * sqe=&sqes[index];
+        std::memset(sqe,0,sizeof(struct io_uring_sqe));
+        sq_array[index]=index;
+        tail++;
+        return sqe;
+    }
+    //! 
+    //! @brief Dodaje do pierścienia zgłoszenie zapisu z kolejki zapisów oczekujących na wysłanie.
+    //! 
+    //! @param file Deskryptor pliku.
+    //! @param tail Koniec pierścienia zgłoszeń.
+    //! @param flags Flagi zgłoszenia.
+    //! 
+    void prepareWrite(int file,unsigned & tail,unsigned char flags){
+        request_t * r=queued.front();
+        struct io_uring_sqe * sqe=prepare(tail);
+        queued.pop_front();
+        sqe->opcode=IORING_OP_WRITEV;
+        sqe->fd=file;
+        sqe->addr=(unsigned long long)r->iov.data();
+        sqe->len=r->iov.size();
+        sqe->off=r->offset;
+        sqe->flags=flags;
+        sqe->user_data=(std::uint64_t)r;
+    }
+    //! 
+    //! @brief Wysyła do jądra zgłoszenia dodane do pierścienia (bez czekania na ich wykonanie).
+    //! 
+    //! @param tail Koniec pierścienia zgłoszeń.
+    //! @param count Liczba zgłoszeń.
+    //! 
+    void send(const unsigned & tail,unsigned count){
+        __atomic_store_n(sq_tail,tail,__ATOMIC_RELEASE);
+        while (count){
+            int r=::syscall(__NR_io_uring_enter,fd,count,0,0,nullptr,0);
+            if (r<0){
+                if (errno==EINTR) continue;
+                throw std::system_error(errno,std::generic_category(),"ict::queue::file::uring_writer io_uring_enter failed!");
+            }
+            count-=r;
+            inflight+=r;
+        }
+    }
+    //! 
+    //! @brief Obsługuje wynik zapisu - pozostała część zapisu wykonanego częściowo (lub anulowanego) jest ponownie dodawana do kolejki.
+    //! 
+    //! @param r Zapis.
+    //! @param result Wynik zgłoszenia.
+    //! 
+    void complete(request_t * r,int result){
+        std::size_t done=(0<result)?result:0;
+        if ((result<0)&&(result!=-ECANCELED)&&(result!=-EINTR)&&(result!=-EAGAIN)){
+            if (!error) error=-result;
+        } else if ((result==0)&&r->size&&(!error)){
+            // Zapis bez postępu (inaczej byłby ponawiany bez końca).
+            error=EIO;
+        }
+        if (error){
+            requests.erase(r->self);
+            return;
+        }
+        r->offset+=done;
+        r->size-=std::min(done,r->size);
+        if (!r->size){
+            requests.erase(r->self);
+            return;
+        }
+        std::vector<struct iovec>::iterator i=r->iov.begin();
+        while ((i!=r->iov.end())&&(i->iov_len<=done)){
+            done-=i->iov_len;
+            i++;
+        }
+        r->iov.erase(r->iov.begin(),i);
+        if (done){
+            r->iov.front().iov_base=((char*)r->iov.front().iov_base)+done;
+            r->iov.front().iov_len-=done;
+        }
+        queued.push_back(r);
+    }
+    //! 
+    //! @brief Odbiera wyniki wykonanych zgłoszeń.
+    //! 
+    //! @param wait Czekanie na co najmniej jeden wynik.
+    //! 
+    void reap(bool wait){
+        unsigned head=*cq_head;
+        unsigned tail=__atomic_load_n(cq_tail,__ATOMIC_ACQUIRE);
+        while (wait&&(head==tail)){
+            int r=::syscall(__NR_io_uring_enter,fd,0,1,IORING_ENTER_GETEVENTS,nullptr,0);
+            if ((r<0)&&(errno!=EINTR)) throw std::system_error(errno,std::generic_category(),"ict::queue::file::uring_writer io_uring_enter failed!");
+            tail=__atomic_load_n(cq_tail,__ATOMIC_ACQUIRE);
+        }
+        for (;head!=tail;head++){
+            const struct io_uring_cqe cqe=cqes[head&(*cq_mask)];
+            inflight--;
+            if (cqe.user_data==datasync_request){
+                if (cqe.res==0) synced=true; else if ((cqe.res!=-ECANCELED)&&(!error)) error=-cqe.res;
+            } else {
+                complete((request_t*)cqe.user_data,cqe.res);
+            }
+        }
+        __atomic_store_n(cq_head,head,__ATOMIC_RELEASE);
+    }
+    //! 
+    //! @brief Zgłasza błąd zapisu (po zakończeniu wszystkich wysłanych zgłoszeń) - niewysłane zapisy są porzucane.
+    //! 
+    void check(){
+        if (!error) return;
+        while (inflight) reap(true);
+        const int e=error;
+        queued.clear();
+        requests.clear();
+        error=0;
+        throw std::system_error(e,std::generic_category(),"ict::queue::file::uring_writer write failed!");
+    }
+    //! 
+    //! @brief Wysyła oczekujące zapisy bez czekania na ich wykonanie (czeka tylko, gdy pierścień jest pełny).
+    //! 
+    //! @param file Deskryptor pliku.
+    //! 
+    void pump(int file){
+        reap(false);
+        while (!queued.empty()){
+            unsigned tail=*sq_tail;
+            unsigned count=0;
+            if (entries<=inflight) reap(true);
+            for (;(!queued.empty())&&((inflight+count)<entries);count++) prepareWrite(file,tail,0);
+            send(tail,count);
+            check();
+        }
+        check();
+    }
+    //! 
+    //! @brief Wysyła oczekujące zapisy i czeka na wykonanie wszystkich zapisów (także zapisów wykonanych częściowo).
+    //! 
+    //! @param file Deskryptor pliku.
+    //! 
+    void drain(int file){
+        pump(file);
+        while (inflight||(!queued.empty())){
+            reap(true);
+            check();
+            pump(file);
+        }
+    }
+    //! 
+    //! @brief Wykonuje wszystkie zapisy i synchronizuje plik z dyskiem. Jeśli nie ma wysłanych zapisów, a oczekujące mieszczą się
+    //!        w pierścieniu, są one łączone (IOSQE_IO_LINK) z synchronizacją i wysyłane razem z nią w jednym wywołaniu.
+    //!        Zapis wykonany częściowo przerywa połączenie - wtedy pozostałe dane są zapisywane i synchronizacja jest ponawiana.
+    //! 
+    //! @param file Deskryptor pliku.
+    //! 
+    void datasync(int file){
+        bool linked=true;
+        do {
+            unsigned tail;
+            unsigned count=0;
+            if ((!linked)||inflight||(entries<=queued.size())) drain(file);
+            tail=*sq_tail;
+            while (!queued.empty()){
+                prepareWrite(file,tail,IOSQE_IO_LINK);
+                count++;
+            }
+            struct io_uring_sqe * sqe=prepare(tail);
+            sqe->opcode=IORING_OP_FSYNC;
+            sqe->fd=file;
+            sqe->fsync_flags=IORING_FSYNC_DATASYNC;
+            sqe->user_data=datasync_request;
+            synced=false;
+            send(tail,count+1);
+            while (inflight) reap(true);
+            check();
+            linked=false;
+        } while ((!synced)||(!queued.empty()));
+    }
+};
+uring_writer::uring_writer(const ict::queue::types::path_t & filename,bool deferredWrites):writer(filename),deferred(deferredWrites){
+    ring.reset(new ring_t);
+    fd=::open(path.c_str(),O_WRONLY|O_CLOEXEC);
+    if (fd<0) throw std::system_error(errno,std::generic_category(),"ict::queue::file::uring_writer open failed!");
+    off_t end=::lseek(fd,0,SEEK_END);
+    if (0<end) position=end;
+}
+uring_writer::~uring_writer(){
+    try {
+        ring->drain(fd);
+    } catch (...) {}
+    // Zgłoszenia muszą zostać zakończone przed zamknięciem pliku.
+    ring.reset();
+    if (0<=fd) ::close(fd);
+}
+void uring_writer::write(const ict::queue::types::const_buffer_t * buffers,const std::size_t & count){
+    std::size_t k=0;
+    while (k<count){
+        ring->requests.emplace_back();
+        ring_t::request_t & r=ring->requests.back();
+        r.self=std::prev(ring->requests.end());
+        r.offset=position;
+        r.size=0;
+        if (deferred){
+            // Zapis wskazuje bufory wywołującego bez kopiowania. Jest to bezpieczne, bo po każdym write() w trybie deferred
+            // (zapis elementu, partii lub informacji o kolejce) w tym samym zakresie wywoływane jest flush() lub sync()
+            // (zob. interface::commitWriteStream()), a dopiero potem wywołujący może zwolnić bufory.
+            for (;(k<count)&&(r.iov.size()<max_uring_iovec);k++){
+                if (!buffers[k].size) continue;
+                r.iov.push_back({(void*)buffers[k].data,buffers[k].size});
+                r.size+=buffers[k].size;
+            }
+        } else {
+            // Zapis pozostaje wysłany po powrocie z write() (także w trakcie kolejnych zapisów), więc dane są kopiowane.
+            for (std::size_t i=k;i<count;i++) r.size+=buffers[i].size;
+            r.copy.reserve(r.size);
+            for (;k<count;k++) r.copy.insert(r.copy.end(),buffers[k].data,buffers[k].data+buffers[k].size);
+            r.iov.push_back({(void*)r.copy.data(),r.copy.size()});
+        }
+        if (!r.size){
+            ring->requests.pop_back();
+            continue;
+        }
+        position+=r.size;
+        ring->queued.push_back(&r);
+    }
+    if (!deferred) ring->pump(fd);
+}
+std::size_t uring_writer::tellp() const{
+    return position;
+}
+void uring_writer::flush(){
+    // Dane muszą być widoczne dla odczytu (także w innych procesach), więc flush() czeka na wykonanie wszystkich zapisów.
+    ring->drain(fd);
+}
+void uring_writer::sync(){
+    ring->datasync(fd);
+}
+#endif
+//===========================================
+} } }
+//===========================================
\ No newline at end of file
@@ -0,0 +1,253 @@
+//! @file
+//! @brief File writer module - header file.
+//! @author Mariusz Ornowski (mariusz.ornowski@ict-project.pl)
+//! @date 2026
+//! @copyright ICT-Project Mariusz Ornowski (ict-project.pl)
+/* **************************************************************
+Copyright (c) 2026, ICT-Project Mariusz Ornowski (ict-project.pl)
+All rights reserved.
+
+Redistribution and use in source and binary forms, with or without
+modification, are permitted provided that the following conditions
+are met:
+
+1. Redistributions of source code must retain the above copyright
+notice, this list of conditions and the following disclaimer.
+2. Redistributions in binary form must reproduce the above copyright
+notice, this list of conditions and the following disclaimer in the
+documentation and/or other materials provided with the distribution.
+3. Neither the name of the ICT-Project Mariusz Ornowski nor the names
+of its contributors may be used to endorse or promote products
+derived from this software without specific prior written permission.
+
+THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+"AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR
+A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT
+HOLDER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,
+SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT
+LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,
+DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY
+THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+(INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+**************************************************************/
+#ifndef _FILE_WRITER_HEADER
+#define _FILE_WRITER_HEADER
+//============================================
+#include "types.hpp"
+#include "file-record.hpp"
+#include <fstream>
+#include <memory>
+//============================================
+namespace ict { namespace  queue { namespace  file {
+//===========================================
+//! Zapis do pliku z danymi kolejki (interfejs wspólny dla różnych sposobów zapisu).
+class writer {
+protected:
+    //! Ścieżka do pliku.
+    const ict::queue::types::path_t path;
+public:
+    //! 
+    //! @brief Konstruktor.
+    //! 
+    //! @param filename Ścieżka do pliku.
+    //! 
+    writer(const ict::queue::types::path_t & filename):path(filename){}
+    virtual ~writer(){}
+    //! 
+    //! @brief Zapisuje dane na końcu pliku.
+    //! 
+    //! @param buffers Bufory z danymi do zapisania (zapisywane jeden za drugim).
+    //! @param count Liczba buforów.
+    //! 
+    virtual void write(const ict::queue::types::const_buffer_t * buffers,const std::size_t & count)=0;
+    //! 
+    //! @brief Zwraca aktualną pozycję zapisu (rozmiar pliku po zapisaniu wszystkich danych).
+    //! 
+    //! @return Pozycja zapisu.
+    //! 
+    virtual std::size_t tellp() const=0;
+    //! 
+    //! @brief Przekazuje zapisane dane do systemu operacyjnego.
+    //! 
+    virtual void flush()=0;
+    //! 
+    //! @brief Przekazuje zapisane dane do systemu operacyjnego i synchronizuje je z dyskiem (fdatasync).
+    //! 
+    virtual void sync()=0;
+    //! 
+    //! @brief Sprawdza, czy plik został zmieniony przez kogoś innego (np. inny proces dopisał dane).
+    //! 
+    //! @return true Plik został zmieniony.
+    //! @return false Plik nie został zmieniony.
+    //! 
+    virtual bool changed() const;
+    //! 
+    //! @brief Zamyka plik do dalszego zapisu (wywoływane przed przejściem do kolejnego pliku).
+    //! 
+    virtual void seal(){}
+    //! 
+    //! @brief Tworzy obiekt zapisu do pliku. Do pustego pliku w formacie compact_format najpierw zapisywany jest nagłówek pliku.
+    //! 
+    //! @param path Ścieżka do pliku.
+    //! @param maxFileSize Maksymalny rozmiar pliku.
+    //! @param format Format pliku.
+    //! @param options Opcje kolejki (m.in. sposób zapisu).
+    //! @return Obiekt zapisu do pliku.
+    //! 
+    static std::unique_ptr<writer> create(const ict::queue::types::path_t & path,const std::size_t & maxFileSize,const ict::queue::types::format_t & format,const ict::queue::types::options_t & options);
+};
+//! Zapis do pliku przez strumień (std::ofstream).
+class stream_writer : public writer {
+private:
+    //! Strumień do zapisu.
+    mutable std::ofstream stream;
+    //! Deskryptor pliku (używany do synchronizacji z dyskiem).
+    int fd=-1;
+public:
+    //! 
+    //! @brief Konstruktor.
+    //! 
+    //! @param filename Ścieżka do pliku.
+    //! @param syncable Czy plik będzie synchronizowany z dyskiem.
+    //! 
+    stream_writer(const ict::queue::types::path_t & filename,bool syncable);
+    ~stream_writer();
+    void write(const ict::queue::types::const_buffer_t * buffers,const std::size_t & count);
+    std::size_t tellp() const;
+    void flush();
+    void sync();
+};
+//! Zapis do pliku bezpośrednio przez deskryptor pliku (writev, bez kopiowania do bufora strumienia).
+class descriptor_writer : public writer {
+private:
+    //! Deskryptor pliku.
+    int fd=-1;
+    //! Pozycja zapisu.
+    std::size_t position=0;
+public:
+    //! 
+    //! @brief Konstruktor.
+    //! 
+    //! @param filename Ścieżka do pliku.
+    //! 
+    descriptor_writer(const ict::queue::types::path_t & filename);
+    ~descriptor_writer();
+    void write(const ict::queue::types::const_buffer_t * buffers,const std::size_t & count);
+    std::size_t tellp() const;
+    void flush();
+    void sync();
+};
+//! Zapis do pliku odwzorowanego w pamięci (mmap). Plik jest wcześniej alokowany (fallocate) do maksymalnego rozmiaru,
+//! a za ostatnim rekordem zawsze znajduje się rekord końca danych (end_of_data_record).
+class mmap_writer : public writer {
+private:
+    //! Deskryptor pliku.
+    int fd=-1;
+    //! Początek odwzorowania pliku w pamięci.
+    char * base=nullptr;
+    //! Rozmiar odwzorowania (i pliku).
+    std::size_t capacity=0;
+    //! Pozycja zapisu (miejsce rekordu końca danych).
+    std::size_t position=0;
+    //! Pozycja, do której dane zostały zsynchronizowane z dyskiem.
+    std::size_t synced=0;
+    //! Format pliku.
+    const ict::queue::types::format_t format;
+    //! Rekord końca danych zakodowany w formacie pliku.
+    char marker[max_record_size];
+    //! Rozmiar rekordu końca danych.
+    std::size_t markerSize=0;
+    //! 
+    //! @brief Powiększa plik (i odwzorowanie), jeśli jest mniejszy niż wymagany rozmiar.
+    //! 
+    //! @param size Wymagany rozmiar.
+    //! 
+    void reserve(const std::size_t & size);
+public:
+    //! 
+    //! @brief Konstruktor.
+    //! 
+    //! @param filename Ścieżka do pliku.
+    //! @param maxFileSize Maksymalny rozmiar pliku (do tego rozmiaru plik jest wcześniej alokowany).
+    //! @param fileFormat Format pliku.
+    //! 
+    mmap_writer(const ict::queue::types::path_t & filename,const std::size_t & maxFileSize,const ict::queue::types::format_t & fileFormat);
+    ~mmap_writer();
+    void write(const ict::queue::types::const_buffer_t * buffers,const std::size_t & count);
+    std::size_t tellp() const;
+    void flush();
+    void sync();
+    bool changed() const;
+    void seal();
+};
+//! Zapis do pliku z pominięciem pamięci podręcznej systemu (O_DIRECT). Dane są kopiowane do wyrównanego bufora,
+//! który jest zapisywany całymi blokami; przy opróżnianiu ostatni blok jest dopełniany rekordem wypełnienia (padding_record).
+class direct_writer : public writer {
+private:
+    //! Deskryptor pliku.
+    int fd=-1;
+    //! Wyrównany bufor.
+    char * staging=nullptr;
+    //! Pozycja w pliku początku bufora (wyrównana do rozmiaru bloku).
+    std::size_t offset=0;
+    //! Liczba bajtów w buforze.
+    std::size_t length=0;
+    //! Format pliku (rekord wypełnienia).
+    const ict::queue::types::format_t format;
+    //! 
+    //! @brief Zapisuje bufor do pliku.
+    //! 
+    //! @param size Liczba bajtów do zapisania (wielokrotność rozmiaru bloku).
+    //! 
+    void writeStaging(const std::size_t & size);
+public:
+    //! 
+    //! @brief Konstruktor.
+    //! 
+    //! @param filename Ścieżka do pliku.
+    //! @param fileFormat Format pliku.
+    //! 
+    direct_writer(const ict::queue::types::path_t & filename,const ict::queue::types::format_t & fileFormat);
+    ~direct_writer();
+    void write(const ict::queue::types::const_buffer_t * buffers,const std::size_t & count);
+    std::size_t tellp() const;
+    void flush();
+    void sync();
+};
+#ifdef ENABLE_IO_URING
+//! Zapis do pliku przez io_uring. Zapisy są kolejkowane i wysyłane do jądra razem, a przy synchronizacji z dyskiem są połączone
+//! (IOSQE_IO_LINK) z operacją fdatasync. Bez opróżniania po każdej operacji (buffered_durability) zapisy pozostają wysłane
+//! w trakcie kolejnych zapisów i są kończone dopiero przez flush() lub sync(). Zapisy wykonane częściowo są ponawiane.
+class uring_writer : public writer {
+private:
+    //! Typ - Stan pierścieni io_uring i zapisy niezakończone.
+    struct ring_t;
+    //! Deskryptor pliku.
+    int fd=-1;
+    //! Pozycja zapisu (po wykonaniu niezakończonych zapisów).
+    std::size_t position=0;
+    //! Czy zapisy czekają na flush() lub sync() i wskazują bufory wywołującego (w przeciwnym razie dane są kopiowane i wysyłane od razu).
+    const bool deferred;
+    //! Stan io_uring.
+    std::unique_ptr<ring_t> ring;
+public:
+    //! 
+    //! @brief Konstruktor.
+    //! 
+    //! @param filename Ścieżka do pliku.
+    //! @param deferredWrites Czy zapisy mogą czekać na flush() lub sync() - bufory z danymi muszą być wtedy dostępne do tego czasu.
+    //! 
+    uring_writer(const ict::queue::types::path_t & filename,bool deferredWrites);
+    ~uring_writer();
+    void write(const ict::queue::types::const_buffer_t * buffers,const std::size_t & count);
+    std::size_t tellp() const;
+    void flush();
+    void sync();
+};
+#endif
+//===========================================
+} } }
+//============================================
+#endif
\ No newline at end of file
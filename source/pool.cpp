@@ -44,6 +44,7 @@ namespace ict { namespace  queue {
 #ifdef ENABLE_TESTING
 #include "test.hpp"
 #include <filesystem>
+#include <vector>
 
 static ict::queue::types::path_t dirpath("/tmp/test-pool");
 REGISTER_TEST(pool,tc1){
@@ -63,5 +64,79 @@ REGISTER_TEST(pool,tc1){
     std::filesystem::remove_all(dirpath);
     return(out);
 }
+REGISTER_TEST(pool,tc2){
+    int out=0;
+    std::filesystem::remove_all(dirpath);
+    std::filesystem::create_directory(dirpath);
+    std::filesystem::remove_all(dirpath+"2");
+    std::filesystem::create_directory(dirpath+"2");
+    {
+        ict::queue::pool_string_string pool(dirpath,100);
+        ict::queue::pool2 pool2(dirpath+"2",100);
+        std::vector<std::string> c;
+        for (const std::string & s : ict::test::test_string) {
+            pool.push(s,"pierwszy");
+            pool2.push(s,"pierwszy",1);
+        }
+        if (pool.pop_n(c,10,"drugi")!=0){
+            out=1;
+        }
+        if ((out==0)&&(pool.pop_n(c,10,"pierwszy")!=10)){
+            out=2;
+        }
+        if ((out==0)&&(pool.pop_n(c,ict::test::test_string.size(),"pierwszy")!=(ict::test::test_string.size()-10))){
+            out=3;
+        }
+        if ((out==0)&&(pool2.pop_n(c,ict::test::test_string.size()+10,"pierwszy",1)!=ict::test::test_string.size())){
+            out=4;
+        }
+        if ((out==0)&&(c.size()!=(2*ict::test::test_string.size()))){
+            out=5;
+        }
+        for (std::size_t k=0;(out==0)&&(k<c.size());k++){
+            std::size_t i=k%ict::test::test_string.size();
+            if (ict::test::test_string.at(i)!=c.at(k)){
+                std::cerr<<"test_string["<<i<<"]="<<ict::test::test_string.at(i)<<std::endl;
+                std::cerr<<"c["<<k<<"]="<<c.at(k)<<std::endl;
+                out=6;
+            }
+        }
+        if ((out==0)&&((!pool.empty())||(!pool2.empty()))){
+            out=7;
+        }
+    }
+    std::filesystem::remove_all(dirpath);
+    std::filesystem::remove_all(dirpath+"2");
+    return(out);
+}
+REGISTER_TEST(pool,tc3){
+    int out=0;
+    std::filesystem::remove_all(dirpath);
+    std::filesystem::create_directory(dirpath);
+    {
+        ict::queue::pool_string_string pool(dirpath,100,2);
+        const std::string item(30,'x');
+        std::string c;
+        std::size_t n=0;
+        if (pool.try_pop(c,"pierwszy")) out=1;
+        for (;(out==0)&&(n<100);n++){
+            ict::queue::types::status_t status=pool.try_push(item,"pierwszy");
+            if (status==ict::queue::types::full_status) break;
+            if (status!=ict::queue::types::success_status) out=2;
+        }
+        if ((out==0)&&((n==0)||(n==100))) out=3;
+        // Pełna kolejka nie blokuje innych kolejek w puli.
+        if ((out==0)&&(pool.try_push(item,"drugi")!=ict::queue::types::success_status)) out=4;
+        if ((out==0)&&(pool.size()!=(n+1))) out=5;
+        for (std::size_t k=0;(out==0)&&(k<n);k++){
+            if ((!pool.try_pop(c,"pierwszy"))||(c!=item)) out=6;
+        }
+        if ((out==0)&&(pool.try_pop(c,"pierwszy"))) out=7;
+        if ((out==0)&&((!pool.try_pop(c,"drugi"))||(c!=item))) out=8;
+        if ((out==0)&&(!pool.empty())) out=9;
+    }
+    std::filesystem::remove_all(dirpath);
+    return(out);
+}
 #endif
 //===========================================
\ No newline at end of file
@@ -67,6 +67,8 @@ public:
         const std::size_t max_file_size;
         //! Maksymalna liczba plików.
         const std::size_t max_files;
+        //! Opcje kolejek.
+        const ict::queue::types::options_t options;
         //! Pula katalogów
         ict::queue::dir::pool dirs;
         //! Lista obiektów obsługujących kolejki.
@@ -76,8 +78,8 @@ public:
         //! Rozmiar kolejki, który ma zostać zwrócony.
         std::size_t size;
         //! Konstruktor.
-        queue_info_t(dir::lockable & dl,const ict::queue::types::path_t & dirname,const std::size_t & maxFileSize=1000000,const std::size_t & maxFiles=0xffffffff):
-            dirlock(dl),dirs(dirname),max_file_size(maxFileSize),max_files(maxFiles){
+        queue_info_t(dir::lockable & dl,const ict::queue::types::path_t & dirname,const std::size_t & maxFileSize=1000000,const std::size_t & maxFiles=0xffffffff,const ict::queue::types::options_t & opt=ict::queue::types::options_t()):
+            dirlock(dl),max_file_size(maxFileSize),max_files(maxFiles),options(opt),dirs(dirname){
         }
         //! 
         //! @brief Dodaje nową kolejkę do puli (jeśli jeszcze nie istnieje).
@@ -90,7 +92,7 @@ public:
                 dirs_change=true;
             }
             if (!queues.count(i)) {
-                queues[i].reset(new Queue(dirs.getPath(i),max_file_size,max_files));
+                queues[i].reset(new Queue(dirs.getPath(i),max_file_size,max_files,options));
             }
         }
         //! 
@@ -136,6 +138,8 @@ public:
         }
     };
     typedef std::function<void(queue_info_t &)> exec_fun_t;
+    //! Typ - Funkcja wykonawcza operacji nieblokujących (zwraca false, jeśli nie ma kolejki do użycia).
+    typedef std::function<bool(queue_info_t &)> try_fun_t;
 protected:
     class _pool_template {
     private:
@@ -145,8 +149,8 @@ protected:
         dir::lockable dirlock;
         queue_info_t qi;
     public:
-        _pool_template(const ict::queue::types::path_t & dirname,const std::size_t & maxFileSize=1000000,const std::size_t & maxFiles=0xffffffff):
-            dirlock(dirname),qi(dirlock,dirname,maxFileSize,maxFiles){
+        _pool_template(const ict::queue::types::path_t & dirname,const std::size_t & maxFileSize=1000000,const std::size_t & maxFiles=0xffffffff,const ict::queue::types::options_t & options=ict::queue::types::options_t()):
+            dirlock(dirname),qi(dirlock,dirname,maxFileSize,maxFiles,options){
         }
         //! 
         //! @brief Dodaje element do kolejki w puli.
@@ -164,6 +168,32 @@ protected:
             qi.afterChange();
         }
         //! 
+        //! @brief Dodaje element do kolejki w puli bez czekania na blokadę.
+        //! 
+        //! @param c Element do dodania.
+        //! @param fun Funkcja wykonawcza (wykonywana przed zwróceniem wartości).
+        //! @return Wynik operacji (success_status, full_status lub locked_status).
+        //! 
+        template<typename ... Args> ict::queue::types::status_t try_push(const container_t & c,const exec_fun_t & fun, Args ... args){
+            std::unique_lock<std::mutex> lock(poolMutex,std::try_to_lock);
+            if (!lock.owns_lock()) return ict::queue::types::locked_status;
+            std::unique_lock<dir::lockable> dlock(dirlock,std::try_to_lock);
+            if (!dlock.owns_lock()) return ict::queue::types::locked_status;
+            ict::queue::types::status_t out;
+            bool created;
+            qi.beforeChange();
+            fun(qi);
+            created=!qi.dirs.exists(qi.id);
+            qi.addQueue(qi.id);
+            out=qi.queues[qi.id]->try_push(c,args ...);
+            // Kolejka utworzona na potrzeby nieudanego zapisu jest usuwana.
+            if (created&&(out!=ict::queue::types::success_status)){
+                qi.removeQueue(qi.id);
+            }
+            qi.afterChange();
+            return out;
+        }
+        //! 
         //! @brief Usuwa element z kolejki w puli.
         //! 
         //! @param c Element usunięty z kolejki.
@@ -183,6 +213,55 @@ protected:
             qi.afterChange();
         }
         //! 
+        //! @brief Usuwa element z kolejki w puli bez czekania na blokadę.
+        //! 
+        //! @param c Element usunięty z kolejki.
+        //! @param fun Funkcja wykonawcza (wykonywana przed zwróceniem wartości).
+        //! @return true Element został usunięty z kolejki.
+        //! @return false Kolejka jest pusta lub zablokowana.
+        //! 
+        template<typename ... Args> bool try_pop(container_t & c,const try_fun_t & fun, Args ... args){
+            std::unique_lock<std::mutex> lock(poolMutex,std::try_to_lock);
+            if (!lock.owns_lock()) return false;
+            std::unique_lock<dir::lockable> dlock(dirlock,std::try_to_lock);
+            if (!dlock.owns_lock()) return false;
+            bool out;
+            qi.beforeChange();
+            if (!fun(qi)) return false;
+            if (!qi.dirs.exists(qi.id)) return false;
+            qi.addQueue(qi.id);
+            out=qi.queues[qi.id]->try_pop(c,args ...);
+            // Sprawdzenie, czy kolejka jest pusta, czekałoby na blokadę, jeśli element nie został odczytany.
+            if (out&&qi.queues[qi.id]->empty(args ...)){
+                qi.removeQueue(qi.id);
+            }
+            qi.afterChange();
+            return out;
+        }
+        //! 
+        //! @brief Usuwa wiele elementów z kolejki w puli.
+        //! 
+        //! @param c Lista, na końcu której są dodawane elementy usunięte z kolejki.
+        //! @param max Maksymalna liczba elementów do usunięcia.
+        //! @param fun Funkcja wykonawcza (wykonywana przed zwróceniem wartości).
+        //! @return Liczba usuniętych elementów.
+        //! 
+        template<typename ... Args> std::size_t pop_n(std::vector<container_t> & c,std::size_t max,const exec_fun_t & fun, Args ... args){
+            std::lock_guard<std::mutex> lock(poolMutex);
+            std::lock_guard<dir::lockable> dlock(dirlock);
+            std::size_t n;
+            qi.beforeChange();
+            fun(qi);
+            if (!qi.dirs.exists(qi.id)) return 0;
+            qi.addQueue(qi.id);
+            n=qi.queues[qi.id]->pop_n(c,max,args ...);
+            if (qi.queues[qi.id]->empty(args ...)){
+                qi.removeQueue(qi.id);
+            }
+            qi.afterChange();
+            return n;
+        }
+        //! 
         //! @brief Zwraca aktualny rozmiar kolejki w puli.
         //! 
         //! @param fun Funkcja wykonawcza (wykonywana przed zwróceniem wartości).
@@ -264,10 +343,10 @@ protected:
             qi.afterChange();
         }
     };
-    dir::singleton<_pool_template,std::size_t,std::size_t> _pt;
+    dir::singleton<_pool_template,std::size_t,std::size_t,ict::queue::types::options_t> _pt;
 public:
-    pool_template(const ict::queue::types::path_t & dirname,const std::size_t & maxFileSize=1000000,const std::size_t & maxFiles=0xffffffff):
-        _pt(dirname,maxFileSize,maxFiles){
+    pool_template(const ict::queue::types::path_t & dirname,const std::size_t & maxFileSize=1000000,const std::size_t & maxFiles=0xffffffff,const ict::queue::types::options_t & options=ict::queue::types::options_t()):
+        _pt(dirname,maxFileSize,maxFiles,options){
     }
     //! 
     //! @brief Dodaje element do kolejki w puli.
@@ -279,6 +358,16 @@ public:
         _pt().push(c,[&](queue_info_t & _qi){_qi.id=i;},args ...);
     }
     //! 
+    //! @brief Dodaje element do kolejki w puli bez czekania na blokadę i bez zgłaszania wyjątku, gdy kolejka jest pełna.
+    //! 
+    //! @param c Element do dodania.
+    //! @param i Identyfikator kolejki w puli.
+    //! @return Wynik operacji: success_status, full_status lub locked_status (pula lub kolejka jest używana przez inny wątek lub proces).
+    //! 
+    template<typename ... Args> ict::queue::types::status_t try_push(const container_t & c,const Identifier & i, Args ... args){
+        return _pt().try_push(c,[&](queue_info_t & _qi){_qi.id=i;},args ...);
+    }
+    //! 
     //! @brief Usuwa element z kolejki w puli.
     //! 
     //! @param c Element usunięty z kolejki.
@@ -288,6 +377,28 @@ public:
         _pt().pop(c,[&](queue_info_t & _qi){_qi.id=i;},args ...);
     }
     //! 
+    //! @brief Usuwa element z kolejki w puli bez czekania na blokadę i bez zgłaszania wyjątku std::underflow_error.
+    //! 
+    //! @param c Element usunięty z kolejki.
+    //! @param i Identyfikator kolejki w puli.
+    //! @return true Element został usunięty z kolejki.
+    //! @return false Kolejka jest pusta lub pula albo kolejka jest używana przez inny wątek lub proces.
+    //! 
+    template<typename ... Args> bool try_pop(container_t & c,const Identifier & i, Args ... args){
+        return _pt().try_pop(c,[&](queue_info_t & _qi){_qi.id=i;return true;},args ...);
+    }
+    //! 
+    //! @brief Usuwa wiele elementów z kolejki w puli (jedna blokada i jedno potwierdzenie odczytu).
+    //! 
+    //! @param c Lista, na końcu której są dodawane elementy usunięte z kolejki.
+    //! @param max Maksymalna liczba elementów do usunięcia.
+    //! @param i Identyfikator kolejki w puli.
+    //! @return Liczba usuniętych elementów (0, jeśli kolejka jest pusta).
+    //! 
+    template<typename ... Args> std::size_t pop_n(std::vector<container_t> & c,std::size_t max,const Identifier & i, Args ... args){
+        return _pt().pop_n(c,max,[&](queue_info_t & _qi){_qi.id=i;},args ...);
+    }
+    //! 
     //! @brief Zwraca aktualny rozmiar kolejki w puli.
     //! 
     //! @param i Identyfikator kolejki w puli.
@@ -204,5 +204,33 @@ REGISTER_TEST(prioritized,tc5){
     std::filesystem::remove_all(dirpath);
     return(out);
 }
+REGISTER_TEST(prioritized,tc6){
+    int out=0;
+    std::filesystem::remove_all(dirpath);
+    std::filesystem::create_directory(dirpath);
+    {
+        ict::queue::prioritized_string queue(dirpath);
+        ict::queue::prioritized_string::priority_t p;
+        std::string c;
+        if (queue.try_pop(c,p)) out=1;
+        for (std::size_t i=0;(out==0)&&(i<ict::test::test_string.size());i++){
+            if (queue.try_push(ict::test::test_string.at(i),i%3)!=ict::queue::types::success_status) out=2;
+        }
+        for (ict::queue::prioritized_string::priority_t e=3;(out==0)&&(0<e);e--){
+            for (std::size_t i=0;(out==0)&&(i<ict::test::test_string.size());i++){
+                if ((i%3)!=(e-1U)) continue;
+                if (!queue.try_pop(c,p)){
+                    out=3;
+                } else if ((p!=(e-1U))||(c!=ict::test::test_string.at(i))){
+                    std::cerr<<"p="<<(int)p<<" c="<<c<<std::endl;
+                    out=4;
+                }
+            }
+        }
+        if ((out==0)&&(queue.try_pop(c,p))) out=5;
+    }
+    std::filesystem::remove_all(dirpath);
+    return(out);
+}
 #endif
 //===========================================
\ No newline at end of file
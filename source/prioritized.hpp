@@ -46,10 +46,10 @@ public:
     typedef pool_template<unsigned char,Queue> parent_t;
     typedef typename Queue::container_t container_t;
     typedef unsigned char priority_t;
-    prioritized_template(const ict::queue::types::path_t & dirname,const std::size_t & maxFileSize=1000000,const std::size_t & maxFiles=0xffffffff):
-        parent_t(dirname,maxFileSize,maxFiles){
+    prioritized_template(const ict::queue::types::path_t & dirname,const std::size_t & maxFileSize=1000000,const std::size_t & maxFiles=0xffffffff,const ict::queue::types::options_t & options=ict::queue::types::options_t()):
+        parent_t(dirname,maxFileSize,maxFiles,options){
     }
-    prioritized_template():parent_t("/tmp/invalid_argument",0,0){
+    prioritized_template():parent_t("/tmp/invalid_argument",0,0,ict::queue::types::options_t()){
         throw std::invalid_argument("ict::queue::prioritized constructor should have arguments!");
     }
     //! 
@@ -67,6 +67,24 @@ public:
             },args ...
         );
     }
+    //! 
+    //! @brief Zwraca element o najwyższym priorytecie bez czekania na blokadę i bez zgłaszania wyjątku std::underflow_error.
+    //! 
+    //! @param c Element usunięty z kolejki.
+    //! @param p Priorytet (od 0 - najniższy, do 255 - najwyższy). 
+    //! @return true Element został usunięty z kolejki.
+    //! @return false Kolejka jest pusta lub używana przez inny wątek lub proces.
+    //! 
+    template<typename ... Args> bool try_pop(container_t & c,priority_t & p, Args ... args){
+        return parent_t::_pt().try_pop(c,[&](typename parent_t::queue_info_t & _qi){
+                _qi.getAllIds();
+                if (_qi.ids.empty()) return false;
+                _qi.id=*_qi.ids.crbegin();
+                p=_qi.id;
+                return true;
+            },args ...
+        );
+    }
 };
 typedef prioritized_template<> prioritized;
 typedef prioritized_template<single_template<std::string>> prioritized_string;
@@ -1,6 +1,7 @@
 #include <iostream>
 #include <sstream>
 #include <string>
+#include <chrono>
 #include "single.hpp"
 //=================================================
 int main(int argc,const char **argv){
@@ -11,7 +12,12 @@ int main(int argc,const char **argv){
         ict::queue::single q(argv[1]);
         std::string s;
         std::stringstream b;
-        q.pop(s);
+        if (argc<3) {
+            q.pop(s);
+        } else if (!q.pop_wait(s,std::chrono::milliseconds(std::stoul(argv[2])))) {
+            std::cerr<<"Timeout!"<<std::endl;
+            return -3;
+        }
         b.str(s);
         std::cout<<b.rdbuf();
     } catch (const std::exception & e){
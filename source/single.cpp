@@ -45,6 +45,15 @@ namespace ict { namespace  queue {
 #include "test.hpp"
 #include <chrono>
 #include <filesystem>
+#include <thread>
+#include <map>
+#include <fstream>
+#include <algorithm>
+#include <unistd.h>
+#include <fcntl.h>
+#include <sys/wait.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
 
 static ict::queue::types::path_t dirpath("/tmp/test-single");
 REGISTER_TEST(single,tc1){
@@ -110,14 +119,14 @@ REGISTER_TEST(single,tc3){
     {
         ict::queue::single queue(dirpath);
         std::size_t max=1000000;
-        std::string out;
+        std::string c;
         auto start=std::chrono::high_resolution_clock::now();
         for (std::size_t k=0;k<max;k++){
             std::size_t i=k%ict::test::test_string.size();
             queue.push(ict::test::test_string.at(i));
         }
         for (std::size_t k=0;k<max;k++){
-            queue.pop(out);
+            queue.pop(c);
         }
         auto elapsed=std::chrono::high_resolution_clock::now()-start;
         long long microseconds=std::chrono::duration_cast<std::chrono::microseconds>(elapsed).count();
@@ -169,5 +178,1222 @@ REGISTER_TEST(single,tc4){
     std::filesystem::remove_all(dirpath);
     return out;
 }
+REGISTER_TEST(single,tc5){
+    int out=0;
+    std::filesystem::remove_all(dirpath);
+    std::filesystem::create_directory(dirpath);
+    {
+        ict::queue::single queue(dirpath,100);
+        queue.push_batch(ict::test::test_string);
+        queue.push(ict::test::test_string.cbegin(),ict::test::test_string.cend());
+        if ((2*ict::test::test_string.size())!=queue.size()){
+            std::cerr<<"test_string.size()="<<ict::test::test_string.size()<<std::endl;//27
+            std::cerr<<"queue.size()="<<queue.size()<<std::endl;
+            out=1;
+        }
+    }
+    if (out==0) {
+        ict::queue::single queue(dirpath,100);
+        for (size_t k=0;(out==0)&&(k<2*ict::test::test_string.size());k++){
+            std::size_t i=k%ict::test::test_string.size();
+            std::string c;
+            queue.pop(c);
+            if (ict::test::test_string.at(i)!=c){
+                std::cerr<<"test_string["<<i<<"]="<<ict::test::test_string.at(i)<<std::endl;
+                std::cerr<<"c="<<c<<std::endl;
+                out=2;
+            }
+        }
+        if ((out==0)&&(!queue.empty())){
+            std::cerr<<"queue.size()="<<queue.size()<<std::endl;
+            out=3;
+        }
+    }
+    std::filesystem::remove_all(dirpath);
+    return out;
+}
+REGISTER_TEST(single,tc6){
+    int out=0;
+    std::filesystem::remove_all(dirpath);
+    std::filesystem::create_directory(dirpath);
+    {
+        // Paczki zapisywane przez granice plików.
+        ict::queue::single queue(dirpath,1000);
+        const std::size_t rounds=10;
+        std::string c;
+        for (std::size_t k=0;k<rounds;k++){
+            queue.push_batch(ict::test::test_string);
+        }
+        if (queue.size()!=rounds*ict::test::test_string.size()){
+            std::cerr<<"queue.size()="<<queue.size()<<std::endl;
+            out=1;
+        }
+        for (std::size_t k=0;(out==0)&&(k<rounds*ict::test::test_string.size());k++){
+            std::size_t i=k%ict::test::test_string.size();
+            queue.pop(c);
+            if (ict::test::test_string.at(i)!=c){
+                std::cerr<<"test_string["<<i<<"]="<<ict::test::test_string.at(i)<<std::endl;
+                std::cerr<<"c="<<c<<std::endl;
+                out=2;
+            }
+        }
+        if ((out==0)&&(!queue.empty())) out=3;
+    }
+    std::filesystem::remove_all(dirpath);
+    return out;
+}
+REGISTER_TEST(single,tc7){
+    int out=0;
+    std::filesystem::remove_all(dirpath);
+    std::filesystem::create_directory(dirpath);
+    {
+        ict::queue::single queue(dirpath);
+        std::size_t threads=8;
+        std::size_t max=200;
+        std::vector<std::thread> producers;
+        std::map<std::string,std::size_t> expected;
+        std::map<std::string,std::size_t> received;
+        for (std::size_t t=0;t<threads;t++){
+            producers.emplace_back([&queue,max,t](){
+                for (std::size_t k=0;k<max;k++){
+                    queue.push(std::to_string(t)+":"+std::to_string(k));
+                }
+            });
+        }
+        for (std::thread & t : producers) t.join();
+        if (queue.size()!=threads*max){
+            std::cerr<<"queue.size()="<<queue.size()<<std::endl;
+            out=1;
+        }
+        for (std::size_t t=0;t<threads;t++){
+            for (std::size_t k=0;k<max;k++){
+                expected[std::to_string(t)+":"+std::to_string(k)]++;
+            }
+        }
+        while ((out==0)&&(!queue.empty())){
+            std::string c;
+            queue.pop(c);
+            received[c]++;
+        }
+        if ((out==0)&&(expected!=received)){
+            std::cerr<<"received.size()="<<received.size()<<std::endl;
+            out=2;
+        }
+    }
+    std::filesystem::remove_all(dirpath);
+    return out;
+}
+REGISTER_TEST(single,tc8){
+    int out=0;
+    const ict::queue::types::durability_t modes[]={
+        ict::queue::types::buffered_durability,
+        ict::queue::types::flush_durability,
+        ict::queue::types::fdatasync_durability,
+        ict::queue::types::periodic_durability
+    };
+    for (const ict::queue::types::durability_t & mode : modes){
+        ict::queue::types::options_t options;
+        std::size_t max=(mode==ict::queue::types::fdatasync_durability)?20:200;
+        std::string input;
+        std::string output;
+        options.durability=mode;
+        input.resize(4000,'x');
+        std::filesystem::remove_all(dirpath);
+        std::filesystem::create_directory(dirpath);
+        {
+            ict::queue::single queue(dirpath,1000000,0xffffffff,options);
+            for (std::size_t k=0;k<max;k++){
+                std::size_t i=k%ict::test::test_string.size();
+                queue.push(ict::test::test_string.at(i));
+            }
+            for (std::size_t k=0;(out==0)&&(k<max);k++){
+                std::size_t i=k%ict::test::test_string.size();
+                queue.pop(output);
+                if (ict::test::test_string.at(i)!=output){
+                    std::cerr<<"durability="<<mode<<", c="<<output<<std::endl;
+                    out=1;
+                }
+            }
+            for (std::size_t k=0;k<max;k++){
+                queue.push(input);
+            }
+        }
+        if (out) break;
+        {
+            // Po ponownym otwarciu wszystkie elementy są w kolejce.
+            ict::queue::single queue(dirpath,1000000,0xffffffff,options);
+            if (queue.size()!=max){
+                std::cerr<<"durability="<<mode<<", queue.size()="<<queue.size()<<std::endl;
+                out=2;
+                break;
+            }
+            queue.pop(output);
+            if (output!=input){
+                out=3;
+                break;
+            }
+        }
+    }
+    std::filesystem::remove_all(dirpath);
+    return out;
+}
+REGISTER_TEST(single,tc9){
+    int out=0;
+    const ict::queue::types::backend_t backends[]={
+        ict::queue::types::stream_backend,
+        ict::queue::types::descriptor_backend,
+        ict::queue::types::mmap_backend,
+        ict::queue::types::uring_backend
+    };
+    const char * names[]={"stream","descriptor","mmap","uring"};
+    const std::size_t sizes[]={4000,32000,128000};
+    for (const std::size_t & size : sizes) for (const ict::queue::types::backend_t & backend : backends){
+        ict::queue::types::options_t options;
+        std::size_t max=700000000/size/10;
+        std::string input;
+        std::string output;
+        options.backend=backend;
+        input.resize(size,'x');
+        std::filesystem::remove_all(dirpath);
+        std::filesystem::create_directory(dirpath);
+        {
+            ict::queue::single queue(dirpath,1000000,0xffffffff,options);
+            auto start=std::chrono::high_resolution_clock::now();
+            for (std::size_t k=0;k<max;k++){
+                queue.push(input);
+            }
+            auto elapsed=std::chrono::high_resolution_clock::now()-start;
+            long long microseconds=std::chrono::duration_cast<std::chrono::microseconds>(elapsed).count();
+            float rate=max*1000000;
+            rate/=microseconds;
+            std::cout<<names[backend]<<": time("<<max<<" writes of "<<input.size()<<" bytes)="<<microseconds<<" microseconds"<<std::endl;
+            std::cout<<names[backend]<<": rate(writes)="<<rate<<" operations/sec"<<std::endl;
+        }
+        {
+            ict::queue::single queue(dirpath,1000000,0xffffffff,options);
+            std::size_t count=0;
+            while(!queue.empty()){
+                queue.pop(output);
+                if (output!=input){
+                    std::cerr<<"output.size()="<<output.size()<<std::endl;
+                    out=1;
+                    break;
+                }
+                count++;
+            }
+            if ((out==0)&&(count!=max)){
+                std::cerr<<"count="<<count<<std::endl;
+                out=2;
+            }
+        }
+        if (out) break;
+    }
+    std::filesystem::remove_all(dirpath);
+    return out;
+}
+REGISTER_TEST(single,tc10){
+    int out=0;
+    const ict::queue::types::backend_t backends[]={
+        ict::queue::types::stream_backend,
+        ict::queue::types::descriptor_backend,
+        ict::queue::types::mmap_backend,
+        ict::queue::types::uring_backend
+    };
+    for (const ict::queue::types::backend_t & backend : backends){
+        ict::queue::types::options_t options;
+        const std::size_t max=20;
+        std::string input;
+        std::string output;
+        options.backend=backend;
+        options.durability=ict::queue::types::fdatasync_durability;
+        std::filesystem::remove_all(dirpath);
+        std::filesystem::create_directory(dirpath);
+        {
+            ict::queue::single queue(dirpath,1000000,0xffffffff,options);
+            for (std::size_t k=0;k<max;k++){
+                input.assign(4000,'a'+k);
+                queue.push(input);
+            }
+            if (queue.size()!=max){
+                std::cerr<<"queue.size()="<<queue.size()<<std::endl;
+                out=1;
+            }
+        }
+        if (out==0){
+            // Elementy zapisane z synchronizacją są odczytywane po ponownym otwarciu kolejki.
+            ict::queue::single queue(dirpath,1000000,0xffffffff,options);
+            for (std::size_t k=0;(out==0)&&(k<max);k++){
+                input.assign(4000,'a'+k);
+                queue.pop(output);
+                if (output!=input) out=2;
+            }
+            if ((out==0)&&(!queue.empty())) out=3;
+        }
+        if (out){
+            std::cerr<<"backend="<<backend<<std::endl;
+            break;
+        }
+    }
+    std::filesystem::remove_all(dirpath);
+    return out;
+}
+REGISTER_TEST(single,tc11){
+    int out=0;
+    const std::size_t max=16;
+    const std::size_t page=::sysconf(_SC_PAGESIZE);
+    ict::queue::types::options_t options;
+    std::string input;
+    std::string output;
+    options.backend=ict::queue::types::direct_backend;
+    options.durability=ict::queue::types::buffered_durability;
+    std::filesystem::remove_all(dirpath);
+    std::filesystem::create_directory(dirpath);
+    {
+        // System plików bez O_DIRECT (np. tmpfs) - zapis przez deskryptor pliku, strony pozostają w pamięci podręcznej.
+        int fd=::open((dirpath+"/probe").c_str(),O_RDWR|O_CREAT|O_DIRECT|O_CLOEXEC,S_IRUSR|S_IWUSR);
+        if (fd<0){
+            std::cout<<"O_DIRECT is not supported - skipped"<<std::endl;
+            std::filesystem::remove_all(dirpath);
+            return 0;
+        }
+        ::close(fd);
+        std::filesystem::remove(dirpath+"/probe");
+    }
+    {
+        ict::queue::single queue(dirpath,10000000,0xffffffff,options);
+        for (std::size_t k=0;k<max;k++){
+            input.assign(64000,'a'+k);
+            queue.push(input);
+        }
+    }
+    for (const std::filesystem::directory_entry & e : std::filesystem::directory_iterator(dirpath)){
+        if (e.path().extension()!=".dat") continue;
+        // Zapisane strony nie są w pamięci podręcznej systemu (poza pierwszym i ostatnim blokiem, zapisanymi także bez O_DIRECT).
+        const std::size_t size=e.file_size();
+        const std::size_t pages=(size+page-1)/page;
+        std::vector<unsigned char> resident(pages);
+        std::size_t count=0;
+        int fd=::open(e.path().c_str(),O_RDONLY|O_CLOEXEC);
+        void * m=(fd<0)?MAP_FAILED:(::mmap(nullptr,size,PROT_READ,MAP_SHARED,fd,0));
+        if ((m==MAP_FAILED)||::mincore(m,size,resident.data())){
+            out=1;
+        } else {
+            for (const unsigned char & r : resident) if (r&1) count++;
+            if (2<count){
+                std::cerr<<"resident="<<count<<"/"<<pages<<std::endl;
+                out=2;
+            }
+        }
+        if (m!=MAP_FAILED) ::munmap(m,size);
+        if (0<=fd) ::close(fd);
+    }
+    if (out==0){
+        ict::queue::single queue(dirpath,10000000,0xffffffff,options);
+        for (std::size_t k=0;(out==0)&&(k<max);k++){
+            input.assign(64000,'a'+k);
+            queue.pop(output);
+            if (output!=input) out=3;
+        }
+        if ((out==0)&&(!queue.empty())) out=4;
+    }
+    std::filesystem::remove_all(dirpath);
+    return out;
+}
+REGISTER_TEST(single,tc12){
+    int out=0;
+    for (std::size_t round=0;(out==0)&&(round<2);round++){
+        ict::queue::types::options_t options;
+        options.group_commit=(round==0);
+        std::filesystem::remove_all(dirpath);
+        std::filesystem::create_directory(dirpath);
+        {
+            ict::queue::single queue(dirpath,100,0xffffffff,options);
+            for (const std::string & s : ict::test::test_string){
+                std::string_view v(s);
+                std::size_t h=s.size()/2;
+                queue.push(v);
+                queue.push(s.data(),s.size());
+                queue.push({{s.data(),h},{s.data()+h,s.size()-h}});
+                queue.push({{s.data(),0},{s.data(),s.size()},{s.data(),0}});
+            }
+            if ((4*ict::test::test_string.size())!=queue.size()){
+                std::cerr<<"round="<<round<<std::endl;
+                std::cerr<<"queue.size()="<<queue.size()<<std::endl;
+                out=1;
+            }
+        }
+        if (out==0) {
+            ict::queue::single queue(dirpath,100,0xffffffff,options);
+            for (size_t k=0;(out==0)&&(k<4*ict::test::test_string.size());k++){
+                std::size_t i=k/4;
+                std::string c;
+                queue.pop(c);
+                if (ict::test::test_string.at(i)!=c){
+                    std::cerr<<"round="<<round<<std::endl;
+                    std::cerr<<"test_string["<<i<<"]="<<ict::test::test_string.at(i)<<std::endl;
+                    std::cerr<<"c="<<c<<std::endl;
+                    out=2;
+                }
+            }
+            if ((out==0)&&(!queue.empty())){
+                std::cerr<<"queue.size()="<<queue.size()<<std::endl;
+                out=3;
+            }
+        }
+    }
+    std::filesystem::remove_all(dirpath);
+    return out;
+}
+REGISTER_TEST(single,tc13){
+    int out=0;
+    std::filesystem::remove_all(dirpath);
+    std::filesystem::create_directory(dirpath);
+    {
+        ict::queue::single queue(dirpath,100);
+        ict::queue::types::buffer_t b;
+        char small[4];
+        queue.push_batch(ict::test::test_string);
+        queue.push_batch(ict::test::test_string);
+        for (size_t i=0;(out==0)&&(i<ict::test::test_string.size());i++){
+            const std::string & t(ict::test::test_string.at(i));
+            std::size_t s=queue.next_size();
+            std::vector<char> c(s);
+            if (s!=t.size()){
+                std::cerr<<"test_string["<<i<<"].size()="<<t.size()<<std::endl;
+                std::cerr<<"s="<<s<<std::endl;
+                out=1;
+                break;
+            }
+            if (sizeof(small)<s){
+                try {
+                    queue.pop_into(small,sizeof(small));
+                    out=2;
+                    break;
+                } catch (const std::length_error &) {}
+            }
+            s=queue.pop_into(c.data(),c.size());
+            if (t!=std::string(c.data(),s)){
+                std::cerr<<"test_string["<<i<<"]="<<t<<std::endl;
+                std::cerr<<"c="<<std::string(c.data(),s)<<std::endl;
+                out=3;
+            }
+        }
+        for (size_t i=0;(out==0)&&(i<ict::test::test_string.size());i++){
+            const std::string & t(ict::test::test_string.at(i));
+            std::size_t capacity=b.capacity();
+            queue.pop(b);
+            if (t!=std::string(b.data(),b.size())){
+                std::cerr<<"test_string["<<i<<"]="<<t<<std::endl;
+                std::cerr<<"b="<<std::string(b.data(),b.size())<<std::endl;
+                out=4;
+            }
+            if ((t.size()<=capacity)&&(b.capacity()!=capacity)){
+                std::cerr<<"capacity="<<capacity<<std::endl;
+                std::cerr<<"b.capacity()="<<b.capacity()<<std::endl;
+                out=5;
+            }
+        }
+        if ((out==0)&&(!queue.empty())){
+            std::cerr<<"queue.size()="<<queue.size()<<std::endl;
+            out=6;
+        }
+    }
+    std::filesystem::remove_all(dirpath);
+    return out;
+}
+REGISTER_TEST(single,tc14){
+    int out=0;
+    std::string input;
+    input.resize(128000,'x');
+    for (std::size_t round=0;(out==0)&&(round<2);round++){
+        const char * name=(round==0)?"string":"buffer";
+        std::size_t max=3000;
+        std::filesystem::remove_all(dirpath);
+        std::filesystem::create_directory(dirpath);
+        {
+            ict::queue::single queue(dirpath);
+            for (std::size_t k=0;k<max;k++){
+                queue.push(input);
+            }
+        }
+        {
+            ict::queue::single queue(dirpath);
+            std::string output;
+            ict::queue::types::buffer_t b;
+            std::size_t count=0;
+            auto start=std::chrono::high_resolution_clock::now();
+            while(!queue.empty()){
+                if (round==0){
+                    std::string().swap(output);
+                    queue.pop(output);
+                } else {
+                    queue.pop(b);
+                }
+                count++;
+            }
+            auto elapsed=std::chrono::high_resolution_clock::now()-start;
+            long long microseconds=std::chrono::duration_cast<std::chrono::microseconds>(elapsed).count();
+            float rate=count*1000000;
+            rate/=microseconds;
+            std::cout<<name<<": time("<<count<<" reads of "<<input.size()<<" bytes)="<<microseconds<<" microseconds"<<std::endl;
+            std::cout<<name<<": rate(reads)="<<rate<<" operations/sec"<<std::endl;
+            if (count!=max){
+                std::cerr<<"count="<<count<<std::endl;
+                out=1;
+            }
+        }
+    }
+    std::filesystem::remove_all(dirpath);
+    return out;
+}
+REGISTER_TEST(single,tc15){
+    int out=0;
+    std::filesystem::remove_all(dirpath);
+    std::filesystem::create_directory(dirpath);
+    {
+        ict::queue::single queue(dirpath,100);
+        std::vector<std::string> c;
+        queue.push_batch(ict::test::test_string);
+        queue.push_batch(ict::test::test_string);
+        while (c.size()<ict::test::test_string.size()){
+            if (queue.pop_n(c,std::min<std::size_t>(5,ict::test::test_string.size()-c.size()))==0){
+                out=1;
+                break;
+            }
+        }
+        for (size_t i=0;(out==0)&&(i<ict::test::test_string.size());i++){
+            if (ict::test::test_string.at(i)!=c.at(i)){
+                std::cerr<<"test_string["<<i<<"]="<<ict::test::test_string.at(i)<<std::endl;
+                std::cerr<<"c="<<c.at(i)<<std::endl;
+                out=2;
+            }
+        }
+    }
+    if (out==0) {
+        ict::queue::single queue(dirpath,100);
+        std::vector<std::string> c;
+        if (ict::test::test_string.size()!=queue.size()){
+            std::cerr<<"queue.size()="<<queue.size()<<std::endl;
+            out=3;
+        } else if (queue.pop_n(c,2*ict::test::test_string.size())!=ict::test::test_string.size()){
+            std::cerr<<"c.size()="<<c.size()<<std::endl;
+            out=4;
+        }
+        for (size_t i=0;(out==0)&&(i<ict::test::test_string.size());i++){
+            if (ict::test::test_string.at(i)!=c.at(i)){
+                std::cerr<<"test_string["<<i<<"]="<<ict::test::test_string.at(i)<<std::endl;
+                std::cerr<<"c="<<c.at(i)<<std::endl;
+                out=5;
+            }
+        }
+        if ((out==0)&&((!queue.empty())||(queue.pop_n(c,10)!=0))){
+            std::cerr<<"queue.size()="<<queue.size()<<std::endl;
+            out=6;
+        }
+    }
+    if (out==0) {
+        ict::queue::single queue(dirpath,100);
+        if (!queue.empty()){
+            std::cerr<<"queue.size()="<<queue.size()<<std::endl;
+            out=7;
+        }
+    }
+    std::filesystem::remove_all(dirpath);
+    return out;
+}
+REGISTER_TEST(single,tc16){
+    int out=0;
+    std::filesystem::remove_all(dirpath);
+    std::filesystem::create_directory(dirpath);
+    {
+        ict::queue::single queue(dirpath,100);
+        std::string c;
+        queue.push_batch(ict::test::test_string);
+        for (size_t i=0;(out==0)&&(i<ict::test::test_string.size());i++){
+            for (int k=0;(out==0)&&(k<3);k++){
+                c.clear();
+                queue.peek(c);
+                if (ict::test::test_string.at(i)!=c){
+                    std::cerr<<"test_string["<<i<<"]="<<ict::test::test_string.at(i)<<std::endl;
+                    std::cerr<<"c="<<c<<std::endl;
+                    out=1;
+                }
+            }
+            if ((out==0)&&(queue.size()!=(ict::test::test_string.size()-i))){
+                std::cerr<<"queue.size()="<<queue.size()<<std::endl;
+                out=2;
+            }
+            if (out==0) queue.commit();
+        }
+        if ((out==0)&&(!queue.empty())){
+            std::cerr<<"queue.size()="<<queue.size()<<std::endl;
+            out=3;
+        }
+        if (out==0){
+            try {
+                queue.commit();
+                out=4;
+            } catch (const std::domain_error &) {
+            }
+        }
+    }
+    if (out==0) {
+        ict::queue::single queue(dirpath,100);
+        std::string c;
+        queue.push(ict::test::test_string.at(0));
+        queue.push(ict::test::test_string.at(1));
+        queue.peek(c);
+        queue.pop(c);
+        if (ict::test::test_string.at(0)!=c){
+            std::cerr<<"c="<<c<<std::endl;
+            out=5;
+        }
+        if (out==0) {
+            queue.peek(c);
+            if (ict::test::test_string.at(1)!=c){
+                std::cerr<<"c="<<c<<std::endl;
+                out=6;
+            }
+        }
+    }
+    if (out==0) {
+        ict::queue::single queue(dirpath,100);
+        std::string c;
+        queue.push(ict::test::test_string.at(2));
+        queue.peek(c);
+        if ((ict::test::test_string.at(1)!=c)||(queue.size()!=2)){
+            std::cerr<<"c="<<c<<std::endl;
+            std::cerr<<"queue.size()="<<queue.size()<<std::endl;
+            out=7;
+        }
+        if (out==0) {
+            // Dopisanie elementu przez inny obiekt wymusza przeładowanie plików przed commit().
+            ict::queue::basic other(dirpath,100);
+            other.writeSize(ict::test::test_string.at(3).size());
+            other.writeContent(ict::test::test_string.at(3).c_str());
+        }
+        if (out==0) {
+            queue.commit();
+            queue.pop(c);
+            if (ict::test::test_string.at(2)!=c){
+                std::cerr<<"c="<<c<<std::endl;
+                out=8;
+            }
+        }
+        if (out==0) {
+            queue.pop(c);
+            if ((ict::test::test_string.at(3)!=c)||(!queue.empty())){
+                std::cerr<<"c="<<c<<std::endl;
+                std::cerr<<"queue.size()="<<queue.size()<<std::endl;
+                out=9;
+            }
+        }
+    }
+    std::filesystem::remove_all(dirpath);
+    return out;
+}
+REGISTER_TEST(single,tc17){
+    int out=0;
+    const ict::queue::types::durability_t modes[]={
+        ict::queue::types::flush_durability,
+        ict::queue::types::fdatasync_durability
+    };
+    const std::size_t intervals[]={0,100};
+    for (std::size_t k=0;(out==0)&&(k<4);k++){
+        const ict::queue::types::durability_t & mode=modes[k/2];
+        const std::size_t & interval=intervals[k%2];
+        ict::queue::types::options_t options;
+        std::size_t max=(mode==ict::queue::types::fdatasync_durability)?300:1000;
+        std::string input("Ala ma kota!");
+        std::string output;
+        options.durability=mode;
+        options.confirm_interval=interval;
+        std::filesystem::remove_all(dirpath);
+        std::filesystem::create_directory(dirpath);
+        {
+            ict::queue::single queue(dirpath,10000000,0xffffffff,options);
+            for (std::size_t k=0;k<max;k++){
+                queue.push(input);
+            }
+            for (std::size_t k=0;k<max;k++){
+                queue.pop(output);
+            }
+            if ((output!=input)||(!queue.empty())){
+                std::cerr<<"queue.size()="<<queue.size()<<std::endl;
+                out=1;
+            }
+        }
+    }
+    std::filesystem::remove_all(dirpath);
+    return out;
+}
+REGISTER_TEST(single,tc18){
+    int out=0;
+    const std::size_t max=20;
+    std::filesystem::remove_all(dirpath);
+    std::filesystem::create_directory(dirpath);
+    {
+        // Pusta kolejka - pop_wait wraca po upływie czasu oczekiwania.
+        ict::queue::single queue(dirpath);
+        std::string c;
+        auto start=std::chrono::steady_clock::now();
+        if (queue.pop_wait(c,std::chrono::milliseconds(50))){
+            out=1;
+        } else if ((std::chrono::steady_clock::now()-start)<std::chrono::milliseconds(50)){
+            out=2;
+        }
+    }
+    if (out==0) {
+        // Zapis w innym wątku tego procesu (zmienna warunkowa).
+        ict::queue::single queue(dirpath);
+        std::string c;
+        std::thread t([]{
+            ict::queue::single queue(dirpath);
+            std::this_thread::sleep_for(std::chrono::milliseconds(20));
+            queue.push(ict::test::test_string.at(3));
+        });
+        if (!queue.pop_wait(c,std::chrono::seconds(5))){
+            out=3;
+        } else if (ict::test::test_string.at(3)!=c){
+            std::cerr<<"c="<<c<<std::endl;
+            out=4;
+        }
+        t.join();
+    }
+    if (out==0) {
+        // Zapis w innym procesie (inotify).
+        pid_t pid=::fork();
+        if (pid==0){
+            ict::queue::single queue(dirpath);
+            std::this_thread::sleep_for(std::chrono::milliseconds(100));
+            for (std::size_t k=0;k<max;k++){
+                queue.push(std::to_string(k));
+                std::this_thread::sleep_for(std::chrono::milliseconds(2));
+            }
+            ::_exit(0);
+        } else if (pid<0){
+            out=5;
+        } else {
+            ict::queue::single queue(dirpath);
+            std::string c;
+            std::size_t k=0;
+            for (;k<max;k++){
+                if (!queue.pop_wait(c,std::chrono::seconds(5))) break;
+                if (c!=std::to_string(k)) break;
+            }
+            ::waitpid(pid,nullptr,0);
+            if (k!=max){
+                std::cerr<<"k="<<k<<", c="<<c<<std::endl;
+                out=6;
+            }
+        }
+    }
+    std::filesystem::remove_all(dirpath);
+    return out;
+}
+REGISTER_TEST(single,tc19){
+    int out=0;
+    std::filesystem::remove_all(dirpath);
+    std::filesystem::create_directory(dirpath);
+    {
+        ict::queue::single queue(dirpath,100,2);
+        const std::string item(30,'x');
+        std::string c;
+        std::size_t n=0;
+        // Pusta kolejka.
+        if (queue.try_pop(c)) out=1;
+        // Pełna kolejka - zapis zatrzymuje się przed przekroczeniem maksymalnej liczby plików.
+        for (;(out==0)&&(n<100);n++){
+            ict::queue::types::status_t status=queue.try_push(item);
+            if (status==ict::queue::types::full_status) break;
+            if (status!=ict::queue::types::success_status){
+                std::cerr<<"status="<<status<<std::endl;
+                out=2;
+            }
+        }
+        if ((out==0)&&((n==0)||(n==100))){
+            std::cerr<<"n="<<n<<std::endl;
+            out=3;
+        }
+        if ((out==0)&&(queue.size()!=n)){
+            std::cerr<<"size="<<queue.size()<<std::endl;
+            out=4;
+        }
+        for (std::size_t k=0;(out==0)&&(k<n);k++){
+            if (!queue.try_pop(c)) {
+                out=5;
+            } else if (c!=item) {
+                out=6;
+            }
+        }
+        if ((out==0)&&(queue.try_pop(c))) out=7;
+        // Po odczycie kolejka znów przyjmuje elementy.
+        if ((out==0)&&(queue.try_push(item)!=ict::queue::types::success_status)) out=8;
+        if ((out==0)&&(!queue.try_pop(c))) out=9;
+    }
+    if (out==0) {
+        // Katalog zablokowany przez inny proces.
+        ict::queue::single queue(dirpath);
+        std::string c;
+        int fd[2];
+        char b=0;
+        if (::pipe(fd)!=0) out=10;
+        pid_t pid=(out==0)?::fork():-1;
+        if (pid==0){
+            ict::queue::dir::lockable dirlock(dirpath);
+            dirlock.lock();
+            if (::write(fd[1],&b,1)!=1) ::_exit(1);
+            std::this_thread::sleep_for(std::chrono::milliseconds(200));
+            dirlock.unlock();
+            ::_exit(0);
+        } else if (pid<0){
+            if (out==0) out=11;
+        } else {
+            if (::read(fd[0],&b,1)!=1) out=12;
+            if ((out==0)&&(queue.try_push(ict::test::test_string.at(0))!=ict::queue::types::locked_status)) out=13;
+            if ((out==0)&&(queue.try_pop(c))) out=14;
+            ::waitpid(pid,nullptr,0);
+            if ((out==0)&&(queue.try_push(ict::test::test_string.at(0))!=ict::queue::types::success_status)) out=15;
+            if ((out==0)&&((!queue.try_pop(c))||(c!=ict::test::test_string.at(0)))) out=16;
+        }
+        if (out!=10){
+            ::close(fd[0]);
+            ::close(fd[1]);
+        }
+    }
+    std::filesystem::remove_all(dirpath);
+    return out;
+}
+REGISTER_TEST(single,tc20){
+    int out=0;
+    const std::size_t max=20000;
+    const std::string input(100,'x');
+    struct variant_t {
+        const char * name;
+        std::size_t read_buffer_size;
+        std::size_t read_ahead;
+    };
+    const variant_t variants[]={
+        {"default stream buffer",0,0},
+        {"read_buffer_size=64KiB",1<<16,0},
+        {"read_buffer_size=64KiB, read_ahead=4MiB",1<<16,1<<22}
+    };
+    for (const variant_t & v : variants){
+        ict::queue::types::options_t options;
+        options.read_buffer_size=v.read_buffer_size;
+        options.read_ahead=v.read_ahead;
+        std::filesystem::remove_all(dirpath);
+        std::filesystem::create_directory(dirpath);
+        {
+            ict::queue::single queue(dirpath,100000,0xffffffff,options);
+            std::vector<std::string> batch(1000,input);
+            for (std::size_t k=0;k<max;k+=batch.size()) queue.push_batch(batch);
+        }
+        // Dane są usuwane z pamięci podręcznej systemu, aby odczyt odbywał się z dysku.
+        for (const std::filesystem::directory_entry & e : std::filesystem::directory_iterator(dirpath)){
+            int fd=::open(e.path().c_str(),O_RDONLY);
+            if (fd<0) continue;
+            ::fdatasync(fd);
+            ::posix_fadvise(fd,0,0,POSIX_FADV_DONTNEED);
+            ::close(fd);
+        }
+        {
+            ict::queue::single queue(dirpath,100000,0xffffffff,options);
+            std::vector<std::string> output;
+            std::size_t count=0;
+            std::size_t n;
+            do {
+                output.clear();
+                n=queue.pop_n(output,1000);
+                count+=n;
+                if (std::count(output.begin(),output.end(),input)!=(std::ptrdiff_t)n){
+                    std::cerr<<v.name<<": wrong content"<<std::endl;
+                    out=2;
+                    break;
+                }
+            } while (n);
+            if ((out==0)&&(count!=max)){
+                std::cerr<<v.name<<": count="<<count<<std::endl;
+                out=1;
+            }
+        }
+        if (out) break;
+    }
+    std::filesystem::remove_all(dirpath);
+    return out;
+}
+REGISTER_TEST(single,tc21){
+    int out=0;
+    std::filesystem::remove_all(dirpath);
+    std::filesystem::create_directory(dirpath);
+    {
+        // Każdy element w osobnym pliku.
+        ict::queue::single queue(dirpath,100);
+        for (const std::string & s : ict::test::test_string) queue.push(s);
+        {
+            ict::queue::single::lease l(queue.pop_view());
+            if (l.view()!=ict::test::test_string.at(0)) out=1;
+            // Element pozostaje w kolejce do zwolnienia dzierżawy.
+            if ((out==0)&&(queue.size()!=ict::test::test_string.size())) out=2;
+            l.release();
+            if ((out==0)&&(queue.size()!=(ict::test::test_string.size()-1))) out=3;
+        }
+        if (out==0){
+            // Destruktor zwalnia dzierżawę.
+            ict::queue::single::lease l(queue.pop_view());
+            if (l.view()!=ict::test::test_string.at(1)) out=4;
+        }
+        if ((out==0)&&(queue.size()!=(ict::test::test_string.size()-2))) out=5;
+        if (out==0){
+            // Inny odczyt anuluje dzierżawę - plik elementu jest usuwany, ale widok pozostaje ważny.
+            std::string c;
+            ict::queue::single::lease l(queue.pop_view());
+            queue.pop(c);
+            if (c!=ict::test::test_string.at(2)) out=6;
+            queue.pop(c);
+            if ((out==0)&&(l.view()!=ict::test::test_string.at(2))) out=7;
+            l.release();
+            if ((out==0)&&(queue.size()!=(ict::test::test_string.size()-4))) out=8;
+        }
+        for (std::size_t i=4;(out==0)&&(i<ict::test::test_string.size());i++){
+            ict::queue::single::lease l(queue.pop_view());
+            if (l.view()!=ict::test::test_string.at(i)) {
+                std::cerr<<"view="<<l.view()<<std::endl;
+                out=9;
+            }
+        }
+        if ((out==0)&&(!queue.empty())) out=10;
+    }
+    if (out==0){
+        // Duże elementy - pop() i pop_view() zwracają tę samą zawartość.
+        const std::size_t max=20;
+        std::string input(128000,'x');
+        ict::queue::single queue(dirpath);
+        for (std::size_t k=0;k<max;k++){
+            input[k]=(char)('a'+k);
+            queue.push(input);
+        }
+        std::string expected(input.size(),'x');
+        for (std::size_t k=0;(out==0)&&(k<max);k++){
+            expected[k]=(char)('a'+k);
+            if (k%2){
+                ict::queue::single::lease l(queue.pop_view());
+                if (l.view()!=expected) out=11;
+            } else {
+                std::string output;
+                queue.pop(output);
+                if (output!=expected) out=11;
+            }
+        }
+        if ((out==0)&&(!queue.empty())) out=12;
+    }
+    std::filesystem::remove_all(dirpath);
+    return out;
+}
+REGISTER_TEST(single,tc22){
+    int out=0;
+    const std::size_t max=300;
+    ict::queue::types::options_t options;
+    std::vector<std::string> items;
+    // Kilka elementów w pliku i kilka wpisów w indeksie każdego pliku.
+    options.index_interval=200;
+    for (std::size_t k=0;k<max;k++) items.push_back("item-"+std::to_string(k)+std::string(k%40,'x'));
+    std::filesystem::remove_all(dirpath);
+    std::filesystem::create_directory(dirpath);
+    {
+        ict::queue::single queue(dirpath,1000,0xffffffff,options);
+        for (std::size_t k=0;(out==0)&&(k<max/2);k++) if (queue.push(items.at(k))!=k) out=1;
+        if ((out==0)&&(queue.push_batch(std::vector<std::string>(items.cbegin()+max/2,items.cend()))!=max/2)) out=2;
+        for (std::size_t k=0;(out==0)&&(k<10);k++){
+            std::string c;
+            if ((queue.pop(c)!=k)||(c!=items.at(k))) out=3;
+        }
+    }
+    if (out==0){
+        std::size_t indexes=0;
+        for (const std::filesystem::directory_entry & e : std::filesystem::directory_iterator(dirpath)) if (e.path().extension()==".idx") indexes++;
+        if (indexes==0) out=4;
+    }
+    if (out==0){
+        // Numery kolejne są zachowane po ponownym otwarciu kolejki.
+        ict::queue::single queue(dirpath,1000,0xffffffff,options);
+        const std::size_t targets[]={10,17,64,130,131,200,299};
+        for (std::size_t t : targets){
+            std::string c;
+            queue.seek(t);
+            if (queue.size()!=(max-t)){
+                std::cerr<<"t="<<t<<" size="<<queue.size()<<std::endl;
+                out=5;
+                break;
+            }
+            if ((queue.pop(c)!=t)||(c!=items.at(t))){
+                std::cerr<<"t="<<t<<" c="<<c<<std::endl;
+                out=6;
+                break;
+            }
+        }
+        if (out==0){
+            // Cofnięcie pozycji w obrębie najstarszego pliku - odczytany element jest ponownie w kolejce.
+            std::string c;
+            queue.seek(max-1);
+            if (queue.size()!=1) out=7;
+            if ((out==0)&&((queue.pop(c)!=(max-1))||(c!=items.at(max-1)))) out=8;
+        }
+        if (out==0){
+            // Elementy z usuniętych plików i elementy, które nie zostały zapisane, nie są dostępne.
+            try {
+                queue.seek(0);
+                out=9;
+            } catch (const std::out_of_range &) {}
+            try {
+                queue.seek(max+1);
+                out=10;
+            } catch (const std::out_of_range &) {}
+        }
+        if (out==0){
+            queue.seek(max);
+            if (!queue.empty()) out=11;
+            if ((out==0)&&(queue.push(items.at(0))!=max)) out=12;
+        }
+        if (out==0){
+            // Usunięte elementy nie zwalniają numerów kolejnych.
+            queue.clear();
+            if (queue.push(items.at(1))!=(max+1)) out=13;
+        }
+    }
+    if (out==0){
+        ict::queue::single queue(dirpath,1000,0xffffffff,options);
+        std::string c;
+        if ((queue.pop(c)!=(max+1))||(c!=items.at(1))) out=14;
+    }
+    std::filesystem::remove_all(dirpath);
+    return out;
+}
+REGISTER_TEST(single,tc23){
+    int out=0;
+    std::filesystem::create_directory(dirpath);
+    {
+        ict::queue::single queue(dirpath);
+        ict::queue::types::state_t state;
+        std::uint64_t last=0;
+        std::string c;
+        int fd[2];
+        char b=0;
+        for (std::size_t k=0;k<3;k++) last=queue.push(ict::test::test_string.at(k));
+        queue.pop(c);
+        if (::pipe(fd)!=0) out=1;
+        pid_t pid=(out==0)?::fork():-1;
+        if (pid==0){
+            ict::queue::dir::lockable dirlock(dirpath);
+            dirlock.lock();
+            if (::write(fd[1],&b,1)!=1) ::_exit(1);
+            std::this_thread::sleep_for(std::chrono::milliseconds(300));
+            dirlock.unlock();
+            ::_exit(0);
+        } else if (pid<0){
+            if (out==0) out=2;
+        } else {
+            std::chrono::steady_clock::time_point start;
+            if (::read(fd[0],&b,1)!=1) out=3;
+            start=std::chrono::steady_clock::now();
+            state=queue.state();
+            const std::chrono::steady_clock::duration d=std::chrono::steady_clock::now()-start;
+            ::waitpid(pid,nullptr,0);
+            if ((out==0)&&((state.size!=2)||(state.read_sequence!=(last-1))||(state.write_sequence!=(last+1))||(state.files==0))){
+                std::cerr<<"state.size="<<state.size<<std::endl;
+                std::cerr<<"state.read_sequence="<<state.read_sequence<<std::endl;
+                std::cerr<<"state.write_sequence="<<state.write_sequence<<std::endl;
+                std::cerr<<"state.files="<<state.files<<std::endl;
+                out=4;
+            }
+            // Stan jest odczytywany bez blokady (katalog jest zablokowany przez inny proces).
+            if ((out==0)&&(d>std::chrono::milliseconds(150))) out=5;
+        }
+        if ((out==0)&&((queue.size()!=2)||queue.empty())) out=6;
+        if (out!=1){
+            ::close(fd[0]);
+            ::close(fd[1]);
+        }
+    }
+    std::filesystem::remove_all(dirpath);
+    return out;
+}
+REGISTER_TEST(single,tc24){
+    int out=0;
+    std::filesystem::create_directory(dirpath);
+    {
+        ict::queue::single queue(dirpath);
+        const ict::queue::dir::lockable::range_t ranges[]={
+            ict::queue::dir::lockable::write_range,
+            ict::queue::dir::lockable::read_range
+        };
+        std::string c;
+        int fd[2];
+        char b=0;
+        for (std::size_t k=0;k<3;k++) queue.push(ict::test::test_string.at(k));
+        queue.pop(c);
+        if (::pipe(fd)!=0) out=1;
+        for (int k=0;(out==0)&&(k<2);k++){
+            pid_t pid=::fork();
+            if (pid==0){
+                // Inny proces blokuje jedną stronę kolejki.
+                ict::queue::dir::lockable side(dirpath,ranges[k]);
+                side.lock();
+                if (::write(fd[1],&b,1)!=1) ::_exit(1);
+                std::this_thread::sleep_for(std::chrono::milliseconds(300));
+                side.unlock();
+                ::_exit(0);
+            } else if (pid<0){
+                out=2;
+            } else {
+                std::chrono::steady_clock::time_point start;
+                if (::read(fd[0],&b,1)!=1) out=3;
+                start=std::chrono::steady_clock::now();
+                // Operacja na drugiej stronie kolejki nie czeka na blokadę, a na tej samej - czeka.
+                if (k==0){
+                    queue.pop(c);
+                    if ((out==0)&&(c!=ict::test::test_string.at(1))) out=4;
+                    if ((out==0)&&(queue.try_push(ict::test::test_string.at(3))!=ict::queue::types::locked_status)) out=5;
+                } else {
+                    queue.push(ict::test::test_string.at(3));
+                    if ((out==0)&&queue.try_pop(c)) out=6;
+                }
+                const std::chrono::steady_clock::duration d=std::chrono::steady_clock::now()-start;
+                ::waitpid(pid,nullptr,0);
+                if ((out==0)&&(d>std::chrono::milliseconds(150))) out=7+k*10;
+            }
+        }
+        if ((out==0)&&(queue.size()!=2)) out=20;
+        if (out==0){
+            queue.pop(c);
+            if (c!=ict::test::test_string.at(2)) out=21;
+        }
+        if (out==0){
+            queue.pop(c);
+            if ((c!=ict::test::test_string.at(3))||(!queue.empty())) out=22;
+        }
+        if (out!=1){
+            ::close(fd[0]);
+            ::close(fd[1]);
+        }
+    }
+    std::filesystem::remove_all(dirpath);
+    return out;
+}
+REGISTER_TEST(single,tc25){
+    int out=0;
+    std::filesystem::create_directory(dirpath);
+    {
+        ict::queue::single queue(dirpath);
+        std::string c;
+        for (std::size_t k=0;k<2;k++) queue.push(ict::test::test_string.at(k));
+        queue.pop(c);
+        {
+            // Zapis i odczyt z pominięciem ict::queue::single (zmiany są widoczne dzięki licznikowi zmian w katalogu).
+            ict::queue::basic other(dirpath);
+            std::size_t s;
+            for (std::size_t k=2;k<5;k++){
+                other.writeSize(ict::test::test_string.at(k).size());
+                other.writeContent(ict::test::test_string.at(k).data());
+            }
+            other.readSize(s);
+            c.resize(s);
+            other.readContent(&c[0]);
+            if (c!=ict::test::test_string.at(1)) out=1;
+        }
+        for (std::size_t k=2;(out==0)&&(k<5);k++){
+            if ((!queue.try_pop(c))||(c!=ict::test::test_string.at(k))){
+                std::cerr<<"k="<<k<<" c="<<c<<std::endl;
+                out=2;
+            }
+        }
+        if ((out==0)&&queue.try_pop(c)) out=3;
+    }
+    std::filesystem::remove_all(dirpath);
+    return out;
+}
+REGISTER_TEST(single,tc26){
+    int out=0;
+    std::filesystem::create_directory(dirpath);
+    {
+        ict::queue::single queue(dirpath);
+        std::string c;
+        for (std::size_t k=0;k<3;k++) queue.push(ict::test::test_string.at(k));
+        if (queue.size()!=3) out=1;
+        if (out==0){
+            // Zapis z pominięciem ict::queue::single - opublikowany stan przestaje być ważny.
+            ict::queue::basic other(dirpath);
+            for (std::size_t k=3;k<5;k++){
+                other.writeSize(ict::test::test_string.at(k).size());
+                other.writeContent(ict::test::test_string.at(k).data());
+            }
+        }
+        if ((out==0)&&(queue.size()!=5)){
+            std::cerr<<"queue.size()="<<queue.size()<<std::endl;
+            out=2;
+        }
+        if (out==0){
+            // Proces kończy się po zapisie danych, bez zamknięcia kolejki (jak po awarii).
+            pid_t pid=::fork();
+            if (pid==0){
+                ict::queue::basic other(dirpath);
+                other.writeSize(ict::test::test_string.at(5).size());
+                other.writeContent(ict::test::test_string.at(5).data());
+                ::_exit(0);
+            }
+            ::waitpid(pid,nullptr,0);
+        }
+        if ((out==0)&&((queue.size()!=6)||queue.empty())){
+            std::cerr<<"queue.size()="<<queue.size()<<std::endl;
+            out=3;
+        }
+        for (std::size_t k=0;(out==0)&&(k<6);k++){
+            queue.pop(c);
+            if (c!=ict::test::test_string.at(k)) out=4;
+        }
+        if ((out==0)&&((queue.size()!=0)||(!queue.empty()))) out=5;
+    }
+    std::filesystem::remove_all(dirpath);
+    return out;
+}
+REGISTER_TEST(single,tc27){
+    int out=0;
+    const std::size_t count=300;
+    std::filesystem::create_directory(dirpath);
+    {
+        // Producent i konsument w różnych procesach - każdy odczytuje tylko pozycję opublikowaną przez drugą stronę (małe pliki - także przejścia do kolejnych plików).
+        ict::queue::single queue(dirpath,2000);
+        std::string c;
+        pid_t pid=::fork();
+        if (pid==0){
+            {
+                ict::queue::single producer(dirpath,2000);
+                for (std::size_t k=0;k<count;k++){
+                    producer.push(ict::test::test_string.at(k%ict::test::test_string.size()));
+                    std::this_thread::sleep_for(std::chrono::microseconds(500));
+                }
+            }
+            ::_exit(0);
+        }
+        for (std::size_t k=0;(out==0)&&(k<count);k++){
+            if (!queue.pop_wait(c,std::chrono::seconds(10))){
+                std::cerr<<"k="<<k<<std::endl;
+                out=1;
+            } else if (c!=ict::test::test_string.at(k%ict::test::test_string.size())) {
+                std::cerr<<"k="<<k<<" c="<<c<<std::endl;
+                out=2;
+            }
+        }
+        int status=-1;
+        ::waitpid(pid,&status,0);
+        if ((out==0)&&((!WIFEXITED(status))||(WEXITSTATUS(status)!=0))) out=3;
+        if ((out==0)&&((queue.size()!=0)||(!queue.empty()))){
+            std::cerr<<"queue.size()="<<queue.size()<<std::endl;
+            out=4;
+        }
+    }
+    std::filesystem::remove_all(dirpath);
+    return out;
+}
 #endif
 //===========================================
\ No newline at end of file
@@ -39,25 +39,203 @@ OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
 #include "basic.hpp"
 #include "dir-lock.hpp"
 #include "dir-singleton.hpp"
+#include "dir-watch.hpp"
 #include <mutex>
+#include <condition_variable>
+#include <exception>
 #include <string>
+#include <string_view>
+#include <vector>
+#include <initializer_list>
+#include <type_traits>
+#include <chrono>
+#include <algorithm>
+#include <memory>
 //============================================
 namespace ict { namespace  queue { 
 //===========================================
 template<class Container=std::string> class single_template {
 public:
     typedef Container container_t;
+    //! Odstęp między sprawdzeniami kolejki w pop_wait(), gdy zapis w innych procesach nie może być wykryty przez inotify.
+    static constexpr std::chrono::milliseconds wait_poll_interval{10};
 private:
     class _single_template {
     private:
+        //! Typ - Element oczekujący na grupowy zapis.
+        struct commit_t {
+            //! Element do dodania (jeden lub wiele buforów).
+            ict::queue::types::gather_t content;
+            //! Informacja, czy zapis został wykonany.
+            bool done=false;
+            //! Numer kolejny zapisanego elementu.
+            std::uint64_t sequence=0;
+            //! Wyjątek zgłoszony podczas zapisu.
+            std::exception_ptr error;
+        };
         //! Kolejka.
         ict::queue::basic queue;
+        //! Opcje kolejki.
+        const ict::queue::types::options_t options;
         //! Mutex dla zapisu.
         std::mutex writeMutex;
         //! Mutex dla odczytu.
         std::mutex readMutex;
-        //! Blokowanie katalogu
-        dir::lockable dirlock;
+        //! Blokada strony zapisu kolejki w katalogu.
+        dir::lockable writelock;
+        //! Blokada strony odczytu kolejki w katalogu.
+        dir::lockable readlock;
+        //! Mutex dla grupowego zapisu.
+        std::mutex commitMutex;
+        //! Zmienna warunkowa, na której czekają wątki oczekujące na grupowy zapis.
+        std::condition_variable commitCond;
+        //! Elementy oczekujące na grupowy zapis.
+        std::vector<commit_t*> commitQueue;
+        //! Informacja, czy któryś z wątków jest liderem grupowego zapisu.
+        bool commitLeader=false;
+        //! Kopia podglądanego elementu (ważna, gdy queue.peeked() i nie ma dzierżawy).
+        Container peekedContent;
+        //! Informacja, że podglądany element jest udostępniony przez dzierżawę (pop_view()), a nie przez peek().
+        bool leased=false;
+        //! Numer ostatniej dzierżawy (zwolnienie wcześniejszej dzierżawy nie usuwa elementu).
+        std::size_t leaseNumber=0;
+        //! Mutex dla oczekiwania na elementy (pop_wait()).
+        std::mutex waitMutex;
+        //! Zmienna warunkowa, na której czekają wątki oczekujące na elementy.
+        std::condition_variable waitCond;
+        //! Licznik zmian w kolejce (zwiększany po każdym zapisie w tym procesie i po każdej zmianie plików w katalogu).
+        std::size_t waitVersion=0;
+        //! Obserwacja katalogu (zapis w innych procesach).
+        dir::watcher watcher;
+        //! 
+        //! @brief Zbiera stan kolejki, gdy opublikowany stan nie jest ważny (zob. state()). Obie strony kolejki muszą być zablokowane.
+        //! 
+        //! @return Stan kolejki.
+        //! 
+        ict::queue::types::state_t collect(){
+            ict::queue::types::state_t s;
+            s.size=queue.size();
+            s.read_sequence=queue.readSequence();
+            s.write_sequence=queue.writeSequence();
+            s.files=queue.files();
+            return s;
+        }
+        //! Typ - Blokada katalogu na czas operacji. Operacja blokuje tylko swoją stronę kolejki (zapis albo odczyt), jeśli liczniki zmian puli plików
+        //! i tej strony nie zmieniły się od ostatniego sprawdzenia plików (pozycja drugiej strony jest wtedy tylko odczytywana z bloku kontrolnego,
+        //! zob. ict::queue::basic::sync()) i operacja nie zmienia puli plików - w przeciwnym razie blokuje obie strony (zawsze najpierw stronę odczytu)
+        //! i sprawdza kolejkę, chyba że wystarczy pozycja opublikowana przez drugą stronę po zakończeniu jej operacji. Operacja na jednej stronie publikuje jej pozycję sama, a przy obu stronach cały stan kolejki jest publikowany na końcu (także po wyjątku).
+        class guard_t {
+        private:
+            //! Kolejka.
+            _single_template & owner;
+            //! Strona kolejki, której dotyczy operacja (whole_range - obie strony).
+            const dir::lockable::range_t range;
+            //! Blokada strony odczytu.
+            std::unique_lock<dir::lockable> read;
+            //! Blokada strony zapisu.
+            std::unique_lock<dir::lockable> write;
+            static bool acquire(std::unique_lock<dir::lockable> & l,const bool & wait){
+                if (wait) {
+                    l.lock();
+                    return true;
+                }
+                return l.try_lock();
+            }
+            //! 
+            //! @brief Sprawdza, czy operacja na jednej stronie może zostać wykonana bez sprawdzania plików (zob. ict::queue::basic::sync()).
+            //! 
+            //! @param count Liczba elementów do zapisu (strona zapisu).
+            //! @param size Łączny rozmiar danych elementów do zapisu (strona zapisu).
+            //! @return true Operacja może zostać wykonana.
+            //! @return false Pliki trzeba sprawdzić.
+            //! 
+            bool ready(const std::size_t & count,const std::size_t & size){
+                if (range==dir::lockable::read_range) return owner.queue.sync(ict::queue::file::control::read_part);
+                return owner.queue.sync(ict::queue::file::control::write_part)&&(!owner.queue.writeHandoff(count,size));
+            }
+        public:
+            guard_t(_single_template & o,const dir::lockable::range_t & r):
+                owner(o),range(r),read(o.readlock,std::defer_lock),write(o.writelock,std::defer_lock){}
+            ~guard_t(){
+                if (owner.reading==this) owner.reading=nullptr;
+                // Także bez zmiany - kolejka mogła zostać przeładowana, a opublikowany stan unieważniony.
+                if (read.owns_lock()&&write.owns_lock()) owner.queue.publish();
+            }
+            //! 
+            //! @brief Blokuje katalog.
+            //! 
+            //! @param count Liczba elementów do zapisu (strona zapisu).
+            //! @param size Łączny rozmiar danych elementów do zapisu (strona zapisu).
+            //! @param wait Czekanie na blokadę.
+            //! @return true Katalog został zablokowany.
+            //! @return false Katalog jest zablokowany przez inny wątek lub proces (tylko bez czekania).
+            //! 
+            bool lock(const std::size_t & count=0,const std::size_t & size=0,const bool & wait=true){
+                if (range!=dir::lockable::whole_range){
+                    std::unique_lock<dir::lockable> & side((range==dir::lockable::write_range)?write:read);
+                    if (!acquire(side,wait)) return false;
+                    if (ready(count,size)){
+                        if (range==dir::lockable::read_range) owner.reading=this;
+                        return true;
+                    }
+                    // Strona zapisu jest zwalniana, aby obie strony były blokowane w tej samej kolejności.
+                    if (range==dir::lockable::write_range) write.unlock();
+                }
+                if ((!read.owns_lock())&&(!acquire(read,wait))) return false;
+                if (!acquire(write,wait)) return false;
+                // Druga strona mogła być w trakcie operacji (jej pozycja nie była jeszcze opublikowana) - po jej zakończeniu pliki nie muszą być sprawdzane.
+                if ((range!=dir::lockable::whole_range)&&ready(count,size)) return true;
+                owner.queue.refresh();
+                return true;
+            }
+            //! 
+            //! @brief Blokuje także stronę zapisu (operacja odczytu zmienia pulę plików, zob. ict::queue::basic::setHandoff()).
+            //! 
+            void upgrade(){
+                if (!write.owns_lock()) write.lock();
+            }
+        };
+        //! Blokada trwającej operacji odczytu (pusta, jeśli nie ma takiej operacji lub obie strony są zablokowane).
+        guard_t * reading=nullptr;
+        //! 
+        //! @brief Budzi wątki oczekujące na elementy.
+        //! 
+        void notify(){
+            {
+                std::lock_guard<std::mutex> lock(waitMutex);
+                waitVersion++;
+            }
+            waitCond.notify_all();
+        }
+        //! 
+        //! @brief Przywraca do kolejki podglądany element (jeśli jest), tak aby mógł zostać odczytany innym sposobem.
+        //! 
+        void unpeek(){
+            if (queue.peeked()) queue.readAbort();
+            leased=false;
+        }
+        //! 
+        //! @brief Zapisuje w kolejce elementy zebrane przez lidera grupowego zapisu.
+        //! 
+        //! @param batch Elementy do zapisania.
+        //! 
+        void commit(const std::vector<commit_t*> & batch){
+            ict::queue::types::gathers_t contents;
+            contents.reserve(batch.size());
+            for (const commit_t * i : batch) contents.push_back(i->content);
+            {
+                std::lock_guard<std::mutex> lock(writeMutex);
+                guard_t guard(*this,dir::lockable::write_range);
+                std::uint64_t sequence;
+                std::size_t s=0;
+                for (const ict::queue::types::gather_t & g : contents) for (std::size_t k=0;k<g.count;k++) s+=g.buffers[k].size;
+                guard.lock(contents.size(),s);
+                sequence=queue.writeSequence();
+                queue.writeBatch(contents);
+                for (commit_t * i : batch) i->sequence=sequence++;
+            }
+            notify();
+        }
     public:
         //! 
         //! @brief Konstruktor kolejki.
@@ -65,35 +243,366 @@ private:
         //! @param dirname Ścieżka do katalogu z plikami.
         //! @param maxFileSize Maksymalny rozmiar pliku, po przekroczeniu którego tworzony jest nowy plik.
         //! @param maxFiles Maksymalna liczba plików w puli.
+        //! @param opt Opcje kolejki.
+        //! 
+        _single_template(const ict::queue::types::path_t & dirname,const std::size_t & maxFileSize=1000000,const std::size_t & maxFiles=0xffffffff,const ict::queue::types::options_t & opt=ict::queue::types::options_t()):
+            queue(dirname,maxFileSize,maxFiles,opt),options(opt),writelock(dirname,dir::lockable::write_range),readlock(dirname,dir::lockable::read_range),
+            watcher(dirname){
+            // Przejście odczytu do następnego pliku zmienia pulę plików - wymaga blokady także strony zapisu.
+            queue.setHandoff([this]{
+                if (reading) reading->upgrade();
+            });
+        }
+        //! 
+        //! @brief Destruktor kolejki - pozycja odczytu i dane, które są jeszcze tylko w pamięci, są zapisywane przed publikacją stanu kolejki.
+        //! 
+        ~_single_template(){
+            try {
+                guard_t guard(*this,dir::lockable::whole_range);
+                guard.lock();
+                queue.flush();
+            } catch (...) {}
+        }
+        //! 
+        //! @brief Dodaje element złożony z wielu buforów do kolejki. Jeśli włączony jest grupowy zapis, element może zostać zapisany
+        //!        przez inny wątek razem z elementami innych wątków (funkcja wraca po zakończeniu zapisu).
+        //! 
+        //! @param buffers Bufory z danymi elementu (zapisywane jeden za drugim).
+        //! @param count Liczba buforów.
+        //! @return Numer kolejny elementu.
+        //! 
+        std::uint64_t push(const ict::queue::types::const_buffer_t * buffers,const std::size_t & count){
+            if (options.group_commit){
+                commit_t item;
+                std::unique_lock<std::mutex> lock(commitMutex);
+                item.content={buffers,count};
+                commitQueue.push_back(&item);
+                while (!item.done){
+                    if (commitLeader){
+                        commitCond.wait(lock);
+                    } else {
+                        std::vector<commit_t*> batch;
+                        std::exception_ptr error;
+                        commitLeader=true;
+                        batch.swap(commitQueue);
+                        lock.unlock();
+                        try {
+                            commit(batch);
+                        } catch (...) {
+                            error=std::current_exception();
+                        }
+                        lock.lock();
+                        for (commit_t * i : batch){
+                            i->error=error;
+                            i->done=true;
+                        }
+                        commitLeader=false;
+                        commitCond.notify_all();
+                    }
+                }
+                lock.unlock();
+                if (item.error) std::rethrow_exception(item.error);
+                return item.sequence;
+            }
+            std::uint64_t sequence;
+            {
+                std::lock_guard<std::mutex> lock(writeMutex);
+                guard_t guard(*this,dir::lockable::write_range);
+                std::size_t s=0;
+                for (std::size_t k=0;k<count;k++) s+=buffers[k].size;
+                guard.lock(1,s);
+                sequence=queue.writeSequence();
+                queue.writeSize(s);
+                queue.writeContent(buffers,count);
+            }
+            notify();
+            return sequence;
+        }
         //! 
-        _single_template(const ict::queue::types::path_t & dirname,const std::size_t & maxFileSize=1000000,const std::size_t & maxFiles=0xffffffff):
-            queue(dirname,maxFileSize,maxFiles),dirlock(dirname){}
+        //! @brief Dodaje element do kolejki, jeśli nie jest ona zablokowana ani pełna (bez grupowego zapisu i bez czekania na blokadę).
         //! 
-        //! @brief Dodaje element do kolejki.
+        //! @param buffers Bufory z danymi elementu (zapisywane jeden za drugim).
+        //! @param count Liczba buforów.
+        //! @return Wynik operacji (success_status, full_status lub locked_status).
         //! 
-        //! @param c Element do dodania.
+        ict::queue::types::status_t try_push(const ict::queue::types::const_buffer_t * buffers,const std::size_t & count){
+            {
+                std::unique_lock<std::mutex> lock(writeMutex,std::try_to_lock);
+                if (!lock.owns_lock()) return ict::queue::types::locked_status;
+                guard_t guard(*this,dir::lockable::write_range);
+                std::size_t s=0;
+                for (std::size_t k=0;k<count;k++) s+=buffers[k].size;
+                if (!guard.lock(1,s,false)) return ict::queue::types::locked_status;
+                if (queue.full(s)) return ict::queue::types::full_status;
+                queue.writeSize(s);
+                queue.writeContent(buffers,count);
+            }
+            notify();
+            return ict::queue::types::success_status;
+        }
+        //! 
+        //! @brief Dodaje wiele elementów do kolejki (jedna blokada, jedno przeładowanie i jedno opróżnienie strumienia).
+        //! 
+        //! @param first Iterator wskazujący pierwszy element do dodania.
+        //! @param last Iterator wskazujący koniec zakresu elementów do dodania.
+        //! @return Numer kolejny pierwszego elementu (kolejne elementy mają kolejne numery).
         //! 
-        void push(const Container & c){
-            std::lock_guard<std::mutex> lock(writeMutex);
-            std::lock_guard<dir::lockable> dlock(dirlock);
-            std::size_t s=c.size()*sizeof(c[0]);
-            queue.refresh();
-            queue.writeSize(s);
-            queue.writeContent((char*)&c[0]);
+        template<class Iterator> std::uint64_t push(Iterator first,Iterator last){
+            ict::queue::types::const_buffers_t contents;
+            std::uint64_t sequence;
+            for (Iterator it=first;it!=last;++it){
+                const Container & c(*it);
+                contents.push_back({(const char*)&c[0],c.size()*sizeof(c[0])});
+            }
+            {
+                std::lock_guard<std::mutex> lock(writeMutex);
+                guard_t guard(*this,dir::lockable::write_range);
+                std::size_t s=0;
+                for (const ict::queue::types::const_buffer_t & b : contents) s+=b.size;
+                guard.lock(contents.size(),s);
+                sequence=queue.writeSequence();
+                queue.writeBatch(contents);
+            }
+            notify();
+            return sequence;
         }
         //! 
         //! @brief Usuwa element z kolejki.
         //! 
         //! @param c Element usunięty z kolejki.
+        //! @return Numer kolejny elementu.
         //! 
-        void pop(Container & c){
+        std::uint64_t pop(Container & c){
             std::lock_guard<std::mutex> lock(readMutex);
-            std::lock_guard<dir::lockable> dlock(dirlock);
+            guard_t guard(*this,dir::lockable::read_range);
+            std::size_t s;
+            std::uint64_t sequence;
+            guard.lock();
+            unpeek();
+            sequence=queue.readSequence();
+            queue.readSize(s);
+            c.resize(s/sizeof(c[0]));
+            queue.readContent((char*)&c[0]);
+            return sequence;
+        }
+        //! 
+        //! @brief Usuwa element z kolejki, jeśli nie jest ona zablokowana ani pusta (bez czekania na blokadę).
+        //! 
+        //! @param c Element usunięty z kolejki.
+        //! @return true Element został usunięty z kolejki.
+        //! @return false Kolejka jest pusta lub zablokowana.
+        //! 
+        bool try_pop(Container & c){
+            std::unique_lock<std::mutex> lock(readMutex,std::try_to_lock);
+            if (!lock.owns_lock()) return false;
+            guard_t guard(*this,dir::lockable::read_range);
             std::size_t s;
-            queue.refresh();
+            if (!guard.lock(0,0,false)) return false;
+            unpeek();
+            if (queue.empty()) return false;
             queue.readSize(s);
             c.resize(s/sizeof(c[0]));
             queue.readContent((char*)&c[0]);
+            return true;
+        }
+        //! 
+        //! @brief Usuwa element z kolejki, czekając na niego, jeśli kolejka jest pusta.
+        //! 
+        //! @param c Element usunięty z kolejki.
+        //! @param deadline Czas, do którego można czekać na element.
+        //! @return true Element został usunięty z kolejki.
+        //! @return false Upłynął czas oczekiwania (kolejka jest pusta).
+        //! 
+        bool pop_wait(Container & c,const std::chrono::steady_clock::time_point & deadline){
+            // Zapis w innym procesie jest wykrywany przez inotify - bez niego (i dla mmap_backend, którego zapisy
+            // nie są zgłaszane przez inotify) kolejka jest sprawdzana co wait_poll_interval.
+            const bool watched=watcher.start([this]{notify();})&&(options.backend!=ict::queue::types::mmap_backend);
+            while (true){
+                std::size_t version;
+                {
+                    std::lock_guard<std::mutex> lock(waitMutex);
+                    version=waitVersion;
+                }
+                {
+                    std::lock_guard<std::mutex> lock(readMutex);
+                    guard_t guard(*this,dir::lockable::read_range);
+                    guard.lock();
+                    unpeek();
+                    if (!queue.empty()){
+                        std::size_t s;
+                        queue.readSize(s);
+                        c.resize(s/sizeof(c[0]));
+                        queue.readContent((char*)&c[0]);
+                        return true;
+                    }
+                }
+                std::unique_lock<std::mutex> lock(waitMutex);
+                std::chrono::steady_clock::time_point now=std::chrono::steady_clock::now();
+                if (deadline<=now) return false;
+                waitCond.wait_until(lock,watched?deadline:std::min(deadline,now+wait_poll_interval),[&]{return waitVersion!=version;});
+            }
+        }
+        //! 
+        //! @brief Usuwa wiele elementów z kolejki (jedna blokada, jedno przeładowanie i jedno potwierdzenie odczytu).
+        //! 
+        //! @param c Lista, na końcu której są dodawane elementy usunięte z kolejki.
+        //! @param max Maksymalna liczba elementów do usunięcia.
+        //! @return Liczba usuniętych elementów.
+        //! 
+        std::size_t pop_n(std::vector<Container> & c,std::size_t max){
+            std::lock_guard<std::mutex> lock(readMutex);
+            guard_t guard(*this,dir::lockable::read_range);
+            std::size_t n=0;
+            guard.lock();
+            unpeek();
+            try {
+                for (;(n<max)&&(!queue.empty());n++){
+                    std::size_t s;
+                    queue.readSize(s);
+                    c.emplace_back();
+                    c.back().resize(s/sizeof(c.back()[0]));
+                    queue.readContent((char*)&c.back()[0],false);
+                }
+            } catch (...) {
+                queue.readConfirm();
+                throw;
+            }
+            queue.readConfirm();
+            return n;
+        }
+        //! 
+        //! @brief Usuwa element z kolejki do bufora wielokrotnego użytku (bez zerowania pamięci).
+        //! 
+        //! @param b Bufor na element usunięty z kolejki.
+        //! @return Numer kolejny elementu.
+        //! 
+        std::uint64_t pop(ict::queue::types::buffer_t & b){
+            std::lock_guard<std::mutex> lock(readMutex);
+            guard_t guard(*this,dir::lockable::read_range);
+            std::size_t s;
+            std::uint64_t sequence;
+            guard.lock();
+            unpeek();
+            sequence=queue.readSequence();
+            queue.readSize(s);
+            b.resize(s);
+            queue.readContent(b.data());
+            return sequence;
+        }
+        //! 
+        //! @brief Usuwa element z kolejki do bufora podanego przez wywołującego.
+        //! 
+        //! @param buf Bufor na dane elementu.
+        //! @param cap Rozmiar bufora.
+        //! @return Rozmiar elementu w bajtach.
+        //! 
+        std::size_t pop_into(char * buf,std::size_t cap){
+            std::lock_guard<std::mutex> lock(readMutex);
+            guard_t guard(*this,dir::lockable::read_range);
+            std::size_t s;
+            guard.lock();
+            unpeek();
+            queue.readSize(s);
+            if (cap<s){
+                queue.readAbort();
+                throw std::length_error("ict::queue::single buffer is too small!");
+            }
+            queue.readContent(buf);
+            return s;
+        }
+        //! 
+        //! @brief Zwraca rozmiar następnego elementu w kolejce (element pozostaje w kolejce).
+        //! 
+        //! @return Rozmiar elementu w bajtach.
+        //! 
+        std::size_t next_size(){
+            std::lock_guard<std::mutex> lock(readMutex);
+            guard_t guard(*this,dir::lockable::read_range);
+            std::size_t s;
+            guard.lock();
+            unpeek();
+            queue.readSize(s);
+            queue.readAbort();
+            return s;
+        }
+        //! 
+        //! @brief Odczytuje pierwszy element z kolejki bez usuwania go (kolejne wywołania zwracają kopię bez operacji na plikach).
+        //! 
+        //! @param c Pierwszy element w kolejce.
+        //! 
+        void peek(Container & c){
+            std::lock_guard<std::mutex> lock(readMutex);
+            if (leased){
+                std::lock_guard<dir::lockable> dlock(readlock);
+                unpeek();
+            }
+            if (!queue.peeked()){
+                guard_t guard(*this,dir::lockable::read_range);
+                std::size_t s;
+                guard.lock();
+                queue.readSize(s);
+                peekedContent.resize(s/sizeof(peekedContent[0]));
+                queue.peekContent((char*)&peekedContent[0]);
+            }
+            c=peekedContent;
+        }
+        //! 
+        //! @brief Usuwa z kolejki element odczytany przez peek().
+        //! 
+        void commit(){
+            std::lock_guard<std::mutex> lock(readMutex);
+            guard_t guard(*this,dir::lockable::whole_range);
+            if ((!queue.peeked())||leased) throw std::domain_error("ict::queue::single peek shuld be done first!");
+            guard.lock();
+            queue.readCommit();
+        }
+        //! 
+        //! @brief Udostępnia pierwszy element bez kopiowania danych (widok w pliku odwzorowanym w pamięci).
+        //!        Element pozostaje w kolejce do czasu zwolnienia dzierżawy (release()).
+        //! 
+        //! @param m Odwzorowanie pliku, do którego należy widok.
+        //! @param content Widok danych elementu.
+        //! @return Numer dzierżawy.
+        //! 
+        std::size_t pop_view(std::shared_ptr<const ict::queue::file::mapping> & m,std::string_view & content){
+            std::lock_guard<std::mutex> lock(readMutex);
+            guard_t guard(*this,dir::lockable::read_range);
+            std::size_t s;
+            guard.lock();
+            unpeek();
+            queue.readSize(s);
+            queue.peekView(m,content);
+            leased=true;
+            return ++leaseNumber;
+        }
+        //! 
+        //! @brief Zwalnia dzierżawę - usuwa udostępniony element z kolejki (zapisuje potwierdzenie odczytu).
+        //!        Jeśli dzierżawa została anulowana przez inny odczyt, element pozostaje w kolejce.
+        //! 
+        //! @param number Numer dzierżawy.
+        //! 
+        void release(const std::size_t & number){
+            std::lock_guard<std::mutex> lock(readMutex);
+            guard_t guard(*this,dir::lockable::whole_range);
+            if ((!leased)||(number!=leaseNumber)||(!queue.peeked())) return;
+            leased=false;
+            guard.lock();
+            queue.readCommit();
+        }
+        //! 
+        //! @brief Zmienia pozycję odczytu - następnym odczytanym elementem będzie element o podanym numerze kolejnym.
+        //! 
+        //! @param sequence Numer kolejny elementu.
+        //! 
+        void seek(const std::uint64_t & sequence){
+            {
+                std::lock_guard<std::mutex> lock(readMutex);
+                guard_t guard(*this,dir::lockable::whole_range);
+                guard.lock();
+                unpeek();
+                queue.seek(sequence);
+            }
+            notify();
         }
         //! 
         //! @brief Zwraca aktualny rozmiar kolejki.
@@ -101,9 +610,7 @@ private:
         //! @return Rozmiar kolejki.
         //! 
         std::size_t size(){
-            std::lock_guard<dir::lockable> dlock(dirlock);
-            queue.refresh();
-            return queue.size();
+            return state().size;
         }
         //! 
         //! @brief Sprawdza, czy kolejka jest pusta.
@@ -112,41 +619,277 @@ private:
         //! @return false Nie jest pusta.
         //! 
         bool empty(){
-            std::lock_guard<dir::lockable> dlock(dirlock);
-            queue.refresh();
-            return queue.empty();
+            return state().size==0;
+        }
+        //! 
+        //! @brief Zwraca stan kolejki. Stan opublikowany w pliku blokady katalogu przez ostatnią operację (w dowolnym procesie)
+        //!        jest odczytywany bez blokowania katalogu - blokada jest potrzebna tylko wtedy, gdy stan nie jest ważny (pliki kolejki
+        //!        zostały zmienione po publikacji, np. przez ict::queue::basic lub zapis przerwany przed publikacją).
+        //! 
+        //! @return Stan kolejki.
+        //! 
+        ict::queue::types::state_t state(){
+            ict::queue::types::state_t s;
+            if (queue.state(s)) return s;
+            // Stan jest publikowany przy zwolnieniu blokady.
+            guard_t guard(*this,dir::lockable::whole_range);
+            guard.lock();
+            return collect();
         }
         //! 
         //! @brief Czyści kolejkę.
         //! 
         void clear(){
-            std::lock_guard<dir::lockable> dlock(dirlock);
-            queue.refresh();
+            guard_t guard(*this,dir::lockable::whole_range);
+            guard.lock();
             queue.clear();
         }
     };
-    dir::singleton<_single_template,std::size_t,std::size_t> _st;
+    typedef dir::singleton<_single_template,std::size_t,std::size_t,ict::queue::types::options_t> singleton_t;
+    singleton_t _st;
 public:
-    single_template(const ict::queue::types::path_t & dirname,const std::size_t & maxFileSize=1000000,const std::size_t & maxFiles=0xffffffff):
-        _st(dirname,maxFileSize,maxFiles){}
-    single_template():_st("/tmp/invalid_argument",0,0){
+    //! Dzierżawa elementu udostępnionego przez pop_view() - widok danych w pliku odwzorowanym w pamięci.
+    //! Zwolnienie dzierżawy (release() lub destruktor) usuwa element z kolejki.
+    class lease {
+    private:
+        friend class single_template;
+        //! Typ - Stan dzierżawy.
+        struct state_t {
+            //! Kolejka, której dotyczy dzierżawa.
+            singleton_t st;
+            //! Odwzorowanie pliku, do którego należy widok.
+            std::shared_ptr<const ict::queue::file::mapping> mapping;
+            //! Widok danych elementu.
+            std::string_view content;
+            //! Numer dzierżawy.
+            std::size_t number;
+            state_t(const singleton_t & s):st(s){}
+        };
+        //! Stan dzierżawy (pusty, jeśli dzierżawa została zwolniona).
+        std::unique_ptr<state_t> state;
+        lease(std::unique_ptr<state_t> && s):state(std::move(s)){}
+    public:
+        lease()=default;
+        lease(lease &&)=default;
+        lease & operator=(lease && other){
+            if (this!=&other){
+                release();
+                state=std::move(other.state);
+            }
+            return *this;
+        }
+        //! 
+        //! @brief Destruktor (zwalnia dzierżawę, błędy są pomijane - element pozostaje wtedy w kolejce).
+        //! 
+        ~lease(){
+            try {
+                release();
+            } catch (...) {}
+        }
+        //! 
+        //! @brief Zwraca widok danych elementu (ważny do czasu zniszczenia dzierżawy, także po jej zwolnieniu).
+        //! 
+        //! @return Widok danych elementu.
+        //! 
+        std::string_view view() const {
+            return state?state->content:std::string_view();
+        }
+        //! 
+        //! @brief Sprawdza, czy dzierżawa nie została zwolniona.
+        //! 
+        explicit operator bool() const {
+            return (bool)state;
+        }
+        //! 
+        //! @brief Zwalnia dzierżawę - usuwa element z kolejki (zapisuje potwierdzenie odczytu).
+        //! 
+        void release(){
+            if (!state) return;
+            std::unique_ptr<state_t> s(std::move(state));
+            s->st().release(s->number);
+        }
+    };
+    single_template(const ict::queue::types::path_t & dirname,const std::size_t & maxFileSize=1000000,const std::size_t & maxFiles=0xffffffff,const ict::queue::types::options_t & options=ict::queue::types::options_t()):
+        _st(dirname,maxFileSize,maxFiles,options){}
+    single_template():_st("/tmp/invalid_argument",0,0,ict::queue::types::options_t()){
         throw std::invalid_argument("ict::queue::single constructor should have arguments!");
     }
     //! 
     //! @brief Dodaje element do kolejki.
     //! 
     //! @param c Element do dodania.
+    //! @return Numer kolejny elementu (kolejne elementy w kolejce mają kolejne numery, zob. seek()).
+    //! 
+    std::uint64_t push(const Container & c){
+        ict::queue::types::const_buffer_t buffer={(const char*)&c[0],c.size()*sizeof(c[0])};
+        return _st().push(&buffer,1);
+    }
+    //! 
+    //! @brief Dodaje element do kolejki bez tworzenia obiektu Container (bez kopiowania danych).
+    //! 
+    //! @param v Element do dodania.
+    //! @return Numer kolejny elementu.
+    //! 
+    template<class View,typename std::enable_if<std::is_same<View,std::string_view>::value,int>::type=0> std::uint64_t push(const View & v){
+        ict::queue::types::const_buffer_t buffer={v.data(),v.size()};
+        return _st().push(&buffer,1);
+    }
+    //! 
+    //! @brief Dodaje element do kolejki bez tworzenia obiektu Container (bez kopiowania danych).
+    //! 
+    //! @param data Wskaźnik do danych elementu.
+    //! @param size Rozmiar danych elementu w bajtach.
+    //! @return Numer kolejny elementu.
+    //! 
+    std::uint64_t push(const void * data,std::size_t size){
+        ict::queue::types::const_buffer_t buffer={(const char*)data,size};
+        return _st().push(&buffer,1);
+    }
+    //! 
+    //! @brief Dodaje do kolejki jeden element złożony z wielu buforów (np. nagłówek i treść), bez ich łączenia.
+    //! 
+    //! @param buffers Bufory z danymi elementu (zapisywane jeden za drugim).
+    //! @return Numer kolejny elementu.
+    //! 
+    std::uint64_t push(std::initializer_list<ict::queue::types::const_buffer_t> buffers){
+        return _st().push(buffers.begin(),buffers.size());
+    }
+    //! 
+    //! @brief Dodaje wiele elementów do kolejki (jedna blokada, jedno przeładowanie i jedno opróżnienie strumienia).
+    //! 
+    //! @param first Iterator wskazujący pierwszy element do dodania.
+    //! @param last Iterator wskazujący koniec zakresu elementów do dodania.
+    //! @return Numer kolejny pierwszego elementu (kolejne elementy mają kolejne numery).
+    //! 
+    template<class Iterator> std::uint64_t push(Iterator first,Iterator last){
+        return _st().push(first,last);
+    }
+    //! 
+    //! @brief Dodaje wiele elementów do kolejki (jedna blokada, jedno przeładowanie i jedno opróżnienie strumienia).
+    //! 
+    //! @param c Elementy do dodania.
+    //! @return Numer kolejny pierwszego elementu (kolejne elementy mają kolejne numery).
+    //! 
+    std::uint64_t push_batch(const std::vector<Container> & c){
+        return _st().push(c.cbegin(),c.cend());
+    }
+    //! 
+    //! @brief Dodaje element do kolejki bez czekania na blokadę i bez zgłaszania wyjątku, gdy kolejka jest pełna.
+    //! 
+    //! @param c Element do dodania.
+    //! @return Wynik operacji: success_status, full_status (element przekroczyłby maksymalną liczbę plików)
+    //!         lub locked_status (kolejka jest używana przez inny wątek lub proces).
     //! 
-    void push(const Container & c){
-        _st().push(c);
+    ict::queue::types::status_t try_push(const Container & c){
+        ict::queue::types::const_buffer_t buffer={(const char*)&c[0],c.size()*sizeof(c[0])};
+        return _st().try_push(&buffer,1);
     }
     //! 
     //! @brief Usuwa element z kolejki.
     //! 
     //! @param c Element usunięty z kolejki.
+    //! @return Numer kolejny elementu.
     //! 
-    void pop(Container & c){
-        _st().pop(c);
+    std::uint64_t pop(Container & c){
+        return _st().pop(c);
+    }
+    //! 
+    //! @brief Usuwa element z kolejki bez czekania na blokadę i bez zgłaszania wyjątku std::underflow_error.
+    //! 
+    //! @param c Element usunięty z kolejki.
+    //! @return true Element został usunięty z kolejki.
+    //! @return false Kolejka jest pusta lub używana przez inny wątek lub proces.
+    //! 
+    bool try_pop(Container & c){
+        return _st().try_pop(c);
+    }
+    //! 
+    //! @brief Usuwa wiele elementów z kolejki (jedna blokada, jedno przeładowanie i jedno potwierdzenie odczytu).
+    //! 
+    //! @param c Lista, na końcu której są dodawane elementy usunięte z kolejki.
+    //! @param max Maksymalna liczba elementów do usunięcia.
+    //! @return Liczba usuniętych elementów (0, jeśli kolejka jest pusta).
+    //! 
+    std::size_t pop_n(std::vector<Container> & c,std::size_t max){
+        return _st().pop_n(c,max);
+    }
+    //! 
+    //! @brief Usuwa element z kolejki, czekając na niego, jeśli kolejka jest pusta (bez zgłaszania wyjątku std::underflow_error).
+    //!        Wątek jest budzony po zapisie w tym procesie (zmienna warunkowa) i po zmianie plików kolejki w innym procesie (inotify).
+    //! 
+    //! @param c Element usunięty z kolejki.
+    //! @param timeout Maksymalny czas oczekiwania.
+    //! @return true Element został usunięty z kolejki.
+    //! @return false Upłynął czas oczekiwania (kolejka jest pusta).
+    //! 
+    template<class Rep,class Period> bool pop_wait(Container & c,const std::chrono::duration<Rep,Period> & timeout){
+        return _st().pop_wait(c,std::chrono::steady_clock::now()+std::chrono::duration_cast<std::chrono::steady_clock::duration>(timeout));
+    }
+    //! 
+    //! @brief Usuwa element z kolejki do bufora wielokrotnego użytku (pamięć rośnie geometrycznie i nie jest zerowana).
+    //! 
+    //! @param b Bufor na element usunięty z kolejki.
+    //! @return Numer kolejny elementu.
+    //! 
+    std::uint64_t pop(ict::queue::types::buffer_t & b){
+        return _st().pop(b);
+    }
+    //! 
+    //! @brief Usuwa element z kolejki do bufora podanego przez wywołującego. Jeśli bufor jest za mały,
+    //!        zgłaszany jest wyjątek std::length_error, a element pozostaje w kolejce (zob. next_size()).
+    //! 
+    //! @param buf Bufor na dane elementu.
+    //! @param cap Rozmiar bufora w bajtach.
+    //! @return Rozmiar elementu w bajtach.
+    //! 
+    std::size_t pop_into(char * buf,std::size_t cap){
+        return _st().pop_into(buf,cap);
+    }
+    //! 
+    //! @brief Zwraca rozmiar następnego elementu w kolejce (element pozostaje w kolejce).
+    //! 
+    //! @return Rozmiar elementu w bajtach.
+    //! 
+    std::size_t next_size(){
+        return _st().next_size();
+    }
+    //! 
+    //! @brief Odczytuje pierwszy element z kolejki bez usuwania go. Kolejne wywołania (do commit() lub innego odczytu)
+    //!        zwracają ten sam element bez operacji na plikach. Element usuwa dopiero commit().
+    //! 
+    //! @param c Pierwszy element w kolejce.
+    //! 
+    void peek(Container & c){
+        _st().peek(c);
+    }
+    //! 
+    //! @brief Usuwa z kolejki element odczytany przez peek(). Bez wcześniejszego peek() zgłaszany jest wyjątek std::domain_error.
+    //! 
+    void commit(){
+        _st().commit();
+    }
+    //! 
+    //! @brief Udostępnia pierwszy element bez kopiowania danych - widok wskazuje bezpośrednio na dane w pliku odwzorowanym w pamięci.
+    //!        Element jest usuwany z kolejki (zapisywane jest potwierdzenie odczytu) dopiero po zwolnieniu dzierżawy.
+    //!        Kolejna dzierżawa lub inny odczyt z tej kolejki anuluje niezwolnioną dzierżawę (element zostanie odczytany ponownie).
+    //! 
+    //! @return Dzierżawa elementu.
+    //! 
+    lease pop_view(){
+        std::unique_ptr<typename lease::state_t> s(new typename lease::state_t(_st));
+        s->number=_st().pop_view(s->mapping,s->content);
+        return lease(std::move(s));
+    }
+    //! 
+    //! @brief Zmienia pozycję odczytu - następnym odczytanym elementem będzie element o podanym numerze kolejnym.
+    //!        Elementy przed nim są usuwane z kolejki. Pozycję można cofnąć do elementów, które zostały już odczytane,
+    //!        ale tylko w obrębie najstarszego pliku (starsze pliki są usuwane). Niezwolniona dzierżawa i podgląd są anulowane.
+    //!        Jeśli elementu nie ma w plikach kolejki, zgłaszany jest wyjątek std::out_of_range.
+    //! 
+    //! @param sequence Numer kolejny elementu (zwrócony przez push() lub pop(); numer następnego zapisanego elementu oznacza koniec kolejki).
+    //! 
+    void seek(const std::uint64_t & sequence){
+        _st().seek(sequence);
     }
     //! 
     //! @brief Zwraca aktualny rozmiar kolejki.
@@ -166,6 +909,14 @@ public:
         return _st().empty();
     }
     //! 
+    //! @brief Zwraca stan kolejki (rozmiar, numery kolejne następnych elementów do odczytu i zapisu, liczbę plików) - zwykle bez blokowania katalogu.
+    //! 
+    //! @return Stan kolejki.
+    //! 
+    ict::queue::types::state_t state(){
+        return _st().state();
+    }
+    //! 
     //! @brief Czyści kolejkę.
     //! 
     void clear(){
@@ -37,6 +37,9 @@ OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
 #define _TYPES_HEADER
 //============================================
 #include <cstdint>
+#include <vector>
+#include <memory>
+#include <algorithm>
 #include <iostream>
 #include <exception>
 #include <stdexcept>
@@ -54,12 +57,196 @@ enum record_type_t {
     //! Informuje o odczycie elementu i wskazuje miejsce w pliku, na którym odczyt się zatrzymał.
     read_confirm_record,
     //! Zapisuje aktualny rozmiar kolejki.
-    queue_size_record
+    queue_size_record,
+    //! Oznacza koniec danych w pliku (za nim jest niewykorzystane, wcześniej zaalokowane miejsce).
+    end_of_data_record,
+    //! Wypełnienie do granicy bloku (zapis O_DIRECT) - zawiera liczbę bajtów do pominięcia, które następują zaraz za tym rekordem.
+    padding_record,
+    //! Zapisuje liczbę elementów odczytanych z kolejki (licznik z pliku kursora) w chwili zapisu rozmiaru kolejki.
+    read_count_record,
+    //! Rekord zawiera rozmiar danych elementu kolejki, który następuje zaraz za tym rekordem, i sumę kontrolną CRC32C rozmiaru i danych.
+    payload_checksum_record
 };
 //! Typ - Rekord zapisywany w pliku.
 struct record_t {
     record_type_t type;
+    //! Suma kontrolna (tylko w rekordzie payload_checksum_record, zajmuje miejsce wyrównania między typem a danymi).
+    std::uint32_t checksum;
     std::size_t data;
+    record_t()=default;
+    record_t(const record_type_t & t,const std::size_t & d,const std::uint32_t & c=0):type(t),checksum(c),data(d){}
+};
+// Na platformach 64-bitowych suma kontrolna nie zmienia rozmiaru rekordu (pliki z wcześniejszych wersji są odczytywane).
+static_assert((sizeof(std::size_t)!=8)||(sizeof(record_t)==16),"ict::queue::types::record_t size has changed!");
+//! Typ - Bufor z danymi elementu kolejki.
+struct const_buffer_t {
+    //! Wskaźnik do danych.
+    const char * data;
+    //! Rozmiar danych.
+    std::size_t size;
+};
+//! Typ - Lista buforów z danymi elementów kolejki.
+typedef std::vector<const_buffer_t> const_buffers_t;
+//! Typ - Element kolejki złożony z wielu buforów (zapisywanych jeden za drugim jako jeden element).
+struct gather_t {
+    //! Wskaźnik do pierwszego bufora.
+    const const_buffer_t * buffers;
+    //! Liczba buforów.
+    std::size_t count;
+};
+//! Typ - Lista elementów kolejki złożonych z wielu buforów.
+typedef std::vector<gather_t> gathers_t;
+//! Typ - Bufor wielokrotnego użytku na dane elementu kolejki. Pamięć rośnie geometrycznie i nie jest zerowana.
+class buffer_t {
+private:
+    //! Pamięć bufora.
+    std::unique_ptr<char[]> storage;
+    //! Rozmiar danych w buforze.
+    std::size_t length=0;
+    //! Rozmiar pamięci bufora.
+    std::size_t allocated=0;
+public:
+    //! 
+    //! @brief Zapewnia, że bufor pomieści podaną liczbę bajtów (zawartość jest zachowywana).
+    //! 
+    //! @param size Wymagany rozmiar pamięci.
+    //! 
+    void reserve(const std::size_t & size){
+        if (size<=allocated) return;
+        std::size_t n=(size<2*allocated)?(2*allocated):size;
+        std::unique_ptr<char[]> s(new char[n]);
+        if (length) std::copy(storage.get(),storage.get()+length,s.get());
+        storage.swap(s);
+        allocated=n;
+    }
+    //! 
+    //! @brief Zmienia rozmiar danych w buforze (nowe bajty nie są inicjowane).
+    //! 
+    //! @param size Nowy rozmiar danych.
+    //! 
+    void resize(const std::size_t & size){
+        reserve(size);
+        length=size;
+    }
+    //! 
+    //! @brief Zwraca wskaźnik do danych.
+    //! 
+    //! @return Wskaźnik do danych.
+    //! 
+    char * data(){
+        return storage.get();
+    }
+    //! 
+    //! @brief Zwraca wskaźnik do danych.
+    //! 
+    //! @return Wskaźnik do danych.
+    //! 
+    const char * data() const{
+        return storage.get();
+    }
+    //! 
+    //! @brief Zwraca rozmiar danych w buforze.
+    //! 
+    //! @return Rozmiar danych.
+    //! 
+    std::size_t size() const{
+        return length;
+    }
+    //! 
+    //! @brief Zwraca rozmiar pamięci bufora.
+    //! 
+    //! @return Rozmiar pamięci.
+    //! 
+    std::size_t capacity() const{
+        return allocated;
+    }
+    //! 
+    //! @brief Sprawdza, czy bufor jest pusty.
+    //! 
+    //! @return true Jest pusty.
+    //! @return false Nie jest pusty.
+    //! 
+    bool empty() const{
+        return length==0;
+    }
+};
+//! Typ - Tryb trwałości zapisu.
+enum durability_t {
+    //! Strumień nie jest opróżniany po każdej operacji (tylko dla kolejek używanych przez jeden proces).
+    buffered_durability=0,
+    //! Strumień jest opróżniany po każdej operacji (dane trafiają do systemu operacyjnego).
+    flush_durability,
+    //! Strumień jest opróżniany i synchronizowany z dyskiem (fdatasync) po każdej operacji.
+    fdatasync_durability,
+    //! Strumień jest opróżniany po każdej operacji i synchronizowany z dyskiem co określony czas lub liczbę bajtów.
+    periodic_durability
+};
+//! Typ - Sposób zapisu do plików.
+enum backend_t {
+    //! Zapis przez strumień (std::ofstream).
+    stream_backend=0,
+    //! Zapis bezpośrednio przez deskryptor pliku (writev, bez kopiowania danych do bufora strumienia).
+    descriptor_backend,
+    //! Zapis do pliku odwzorowanego w pamięci (mmap) i wcześniej zaalokowanego (fallocate) do maksymalnego rozmiaru.
+    mmap_backend,
+    //! Zapis asynchroniczny przez io_uring (zapis i synchronizacja z dyskiem w jednym wywołaniu systemowym);
+    //! jeśli io_uring nie jest dostępny, używany jest descriptor_backend.
+    uring_backend,
+    //! Zapis z pominięciem pamięci podręcznej systemu (O_DIRECT) przez wyrównany bufor; każdy zapis jest dopełniany do granicy bloku.
+    direct_backend
+};
+//! Typ - Format rekordów w plikach kolejki.
+enum format_t {
+    //! Rekordy o stałym rozmiarze (record_t, 16 bajtów), bez nagłówka pliku - format wcześniejszych wersji.
+    legacy_format=1,
+    //! Plik zaczyna się od nagłówka (sygnatura i wersja formatu), a typ i rozmiar rekordu są kodowane jako liczba o zmiennej długości (varint).
+    compact_format=2
+};
+//! Typ - Wynik operacji nieblokującej (try_push()).
+enum status_t {
+    //! Operacja została wykonana.
+    success_status=0,
+    //! Kolejka jest pełna (element przekroczyłby maksymalną liczbę plików).
+    full_status,
+    //! Kolejka jest zablokowana przez inny wątek lub proces.
+    locked_status
+};
+//! Typ - Stan kolejki (publikowany w pliku blokady katalogu, zob. ict::queue::single::state()).
+struct state_t {
+    //! Rozmiar kolejki.
+    std::uint64_t size=0;
+    //! Numer kolejny następnego elementu do odczytu.
+    std::uint64_t read_sequence=0;
+    //! Numer kolejny następnego zapisanego elementu.
+    std::uint64_t write_sequence=0;
+    //! Liczba plików kolejki.
+    std::uint64_t files=0;
+};
+//! Typ - Opcje kolejki.
+struct options_t {
+    //! Grupowy zapis - jeden wątek (lider) zapisuje elementy wszystkich wątków oczekujących na zapis.
+    bool group_commit=true;
+    //! Tryb trwałości zapisu.
+    durability_t durability=flush_durability;
+    //! Czas w milisekundach, po którym następuje synchronizacja z dyskiem (tryb periodic_durability, 0 - wyłączone). Czas jest sprawdzany przy
+    //! każdej operacji i przez wątek kolejki, więc dane są synchronizowane także wtedy, gdy po zapisie (odczycie) kolejka nie jest używana.
+    std::size_t sync_interval_ms=1000;
+    //! Liczba bajtów, po zapisaniu których następuje synchronizacja z dyskiem (tryb periodic_durability, 0 - wyłączone).
+    std::size_t sync_interval_bytes=0;
+    //! Sposób zapisu do plików.
+    backend_t backend=stream_backend;
+    //! Liczba odczytów, po których zapisywana jest pozycja odczytu (0 - wyłączone; jeśli confirm_interval_ms też jest 0, pozycja jest zapisywana po każdym odczycie).
+    std::size_t confirm_interval=0;
+    //! Czas w milisekundach, po którym zapisywana jest pozycja odczytu (0 - wyłączone; zob. confirm_interval).
+    std::size_t confirm_interval_ms=0;
+    //! Rozmiar bufora strumienia do odczytu w bajtach (0 - domyślny bufor strumienia).
+    std::size_t read_buffer_size=1<<16;
+    //! Liczba bajtów odczytywanych z wyprzedzeniem przez osobny wątek, także z następnego pliku (0 - wyłączone).
+    std::size_t read_ahead=0;
+    //! Minimalny odstęp w bajtach między wpisami w rzadkim indeksie pliku (numer kolejny elementu -> pozycja w pliku, zob. seek(); 0 - bez indeksu).
+    std::size_t index_interval=1<<16;
+    //! Format nowych plików (pliki zapisane wcześniej w innym formacie są odczytywane i uzupełniane w swoim formacie).
+    format_t format=compact_format;
 };
 //! 
 //! @brief Zapis rekordu do pliku.